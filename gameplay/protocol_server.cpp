@@ -0,0 +1,192 @@
+/**
+ * @file protocol_server.cpp
+ * @brief Implementation of ProtocolServer class
+ */
+
+#include "protocol_server.hpp"
+#include "../solver/opening_book.hpp"
+#include "../solver/strategy_selector.hpp"
+#include "../utils/utils.hpp"
+#include <array>
+#include <charconv>
+#include <exception>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <utility>
+
+namespace {
+
+constexpr size_t flushThreshold{64 * 1024}; ///< Reply bytes forcing a write
+
+/**
+ * @brief Append a reply line
+ * @param replies Buffer the reply is appended to
+ * @param verb First token of the reply
+ * @param id The session id
+ * @param value Rest of the reply, if any
+ */
+void appendReply(std::string& replies, const std::string_view verb,
+                 const std::string_view id,
+                 const std::string_view value = {}) {
+  replies.append(verb).append(1, ' ').append(id);
+  if (!value.empty()) {
+    replies.append(1, ' ').append(value);
+  }
+  replies.append(1, '\n');
+}
+
+/**
+ * @brief Append a reply line ending in a number
+ * @param replies Buffer the reply is appended to
+ * @param verb First token of the reply
+ * @param id The session id
+ * @param value The number
+ * @param base Base the number is written in
+ */
+void appendReply(std::string& replies, const std::string_view verb,
+                 const std::string_view id, const int32_t value,
+                 const int base) {
+  std::array<char, 16> digits{};
+  const char* const end{
+      std::to_chars(digits.data(), digits.data() + digits.size(), value, base)
+          .ptr};
+  appendReply(replies, verb, id,
+              std::string_view{digits.data(),
+                               static_cast<size_t>(end - digits.data())});
+}
+
+} // namespace
+
+ProtocolServer::ProtocolServer(
+    std::vector<std::shared_ptr<const OpeningBook>> openingBooks)
+    : m_openingBooks{std::move(openingBooks)} {}
+
+void ProtocolServer::handle(const std::string_view request,
+                            std::string& replies) {
+  std::string_view rest{request};
+  if (!rest.empty() && rest.back() == '\r') {
+    rest.remove_suffix(1);
+  }
+
+  const std::string_view command{utils::nextToken(rest)};
+  if (command.empty()) {
+    return;
+  }
+
+  const std::string_view id{utils::nextToken(rest)};
+  const std::string_view argument{utils::nextToken(rest)};
+  if (id.empty()) {
+    appendReply(replies, "ERR", "-", "missing session id");
+    return;
+  }
+
+  if (command == "NEW") {
+    startSession(id, argument, replies);
+  } else if (command == "FB") {
+    applyFeedback(id, argument, replies);
+  } else if (command == "END") {
+    if (const auto session{m_sessions.find(id)}; session != m_sessions.end()) {
+      m_sessions.erase(session);
+    }
+    appendReply(replies, "OK", id);
+  } else {
+    appendReply(replies, "ERR", id, "unknown command");
+  }
+}
+
+void ProtocolServer::startSession(const std::string_view id,
+                                  const std::string_view strategyKey,
+                                  std::string& replies) {
+  const auto strategy{StrategySelector::parseStrategyKey(strategyKey)};
+  if (!strategy.has_value()) {
+    appendReply(replies, "ERR", id, "unknown strategy");
+    return;
+  }
+
+  auto session{m_sessions.find(id)};
+  if (session == m_sessions.end()) {
+    session = m_sessions.try_emplace(std::string{id}).first;
+  }
+
+  Session& state{session->second};
+  state.solver =
+      HeuristicSolver{HeuristicSolver::convertStrategy(strategy.value())};
+  for (const auto& book : m_openingBooks) {
+    state.solver.addOpeningBook(book);
+  }
+  state.guessCount = 0;
+  sendGuess(session, replies);
+}
+
+void ProtocolServer::applyFeedback(const std::string_view id,
+                                   const std::string_view feedback,
+                                   std::string& replies) {
+  const auto session{m_sessions.find(id)};
+  if (session == m_sessions.end()) {
+    appendReply(replies, "ERR", id, "unknown session");
+    return;
+  }
+
+  const auto counts{utils::parseFeedback(feedback)};
+  if (!counts.has_value()) {
+    appendReply(replies, "ERR", id, "invalid feedback");
+    return;
+  }
+
+  Session& state{session->second};
+  const auto [aCount, bCount]{counts.value()};
+  if (aCount == utils::numberSize) {
+    appendReply(replies, "SOLVED", id, state.guessCount, 10);
+    m_sessions.erase(session);
+    return;
+  }
+
+  state.solver.updateGuess(state.guess, aCount, bCount);
+  sendGuess(session, replies);
+}
+
+void ProtocolServer::sendGuess(const SessionMap::iterator session,
+                               std::string& replies) {
+  const std::string_view id{session->first};
+  Session& state{session->second};
+
+  std::optional<int32_t> guess;
+  try {
+    guess = state.solver.nextGuess();
+  } catch (const std::exception& e) {
+    appendReply(replies, "ERR", id, e.what());
+    m_sessions.erase(session);
+    return;
+  }
+
+  if (!guess.has_value()) {
+    appendReply(replies, "ERR", id, "no candidates left");
+    m_sessions.erase(session);
+    return;
+  }
+
+  state.guess = guess.value();
+  ++state.guessCount;
+  appendReply(replies, "GUESS", id, state.guess, utils::alphabetSize);
+}
+
+void ProtocolServer::run(std::istream& in, std::ostream& out) {
+  ProtocolServer server{OpeningBook::loadDirectory("opening_books")};
+
+  std::string request;
+  std::string replies;
+  const auto flush{[&out, &replies] {
+    out.write(replies.data(), static_cast<std::streamsize>(replies.size()));
+    out.flush();
+    replies.clear();
+  }};
+
+  while (std::getline(in, request)) {
+    server.handle(request, replies);
+    if (in.rdbuf()->in_avail() <= 0 || replies.size() >= flushThreshold) {
+      flush();
+    }
+  }
+  flush();
+}
@@ -0,0 +1,135 @@
+/**
+ * @file protocol_server.hpp
+ * @brief Line protocol for driving many solver sessions from another process
+ */
+
+#pragma once
+
+#include "../solver/heuristic_solver.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class OpeningBook;
+
+/**
+ * @class ProtocolServer
+ * @brief Multiplexes solver sessions over a terse request-reply protocol
+ *
+ * Every request and reply is one line of space-separated tokens, and every
+ * request gets exactly one reply:
+ *
+ * - `NEW <id> <strategy>` starts session `<id>`, replacing any session of
+ *   that id, and replies `GUESS <id> <number>`. The strategy is a key such as
+ *   `hybrid` (see StrategySelector::getStrategyKey).
+ * - `FB <id> <feedback>` reports the feedback, such as `1A2B`, on the last
+ *   guess of a session. The reply is the next `GUESS <id> <number>`, or
+ *   `SOLVED <id> <guesses>` once all digits are right, which ends the session.
+ * - `END <id>` forgets a session and replies `OK <id>`.
+ *
+ * A failed request replies `ERR <id> <reason>`, with `-` for a missing id.
+ * Sessions whose feedback leaves no candidate, or whose solver fails, are
+ * dropped. Guessed numbers are written in base utils::alphabetSize, guess
+ * counts in base 10.
+ *
+ * Ids are arbitrary tokens chosen by the client. Sessions are independent,
+ * so a client may interleave the requests of as many as it likes; each
+ * session scores its guesses on the calling thread.
+ */
+class ProtocolServer {
+public:
+  /**
+   * @brief Construct a server with no sessions
+   * @param openingBooks Books registered with every new session
+   */
+  explicit ProtocolServer(
+      std::vector<std::shared_ptr<const OpeningBook>> openingBooks = {});
+
+  /**
+   * @brief Answer one request
+   * @param request The request line, without its line break
+   * @param replies Buffer the reply line is appended to, with its line break
+   *
+   * Blank requests are ignored and get no reply.
+   */
+  void handle(std::string_view request, std::string& replies);
+
+  /**
+   * @brief Get the number of open sessions
+   * @return Sessions started and not yet ended
+   */
+  [[nodiscard]] size_t getSessionCount() const { return m_sessions.size(); }
+
+  /**
+   * @brief Serve requests from a stream until it ends
+   * @param in Source of request lines
+   * @param out Destination of reply lines
+   *
+   * Opening books are loaded from the opening_books directory. Replies are
+   * buffered and written whenever no further request is waiting in the
+   * input, so a pipelined batch is answered with one write while a client
+   * waiting on each reply still gets it at once.
+   */
+  static void run(std::istream& in, std::ostream& out);
+
+private:
+  /**
+   * @struct Session
+   * @brief State of one client game
+   */
+  struct Session {
+    HeuristicSolver solver; ///< Solver narrowed by the feedback so far
+    int32_t guess{0};       ///< Last guess sent to the client
+    int32_t guessCount{0};  ///< Guesses sent, including the last
+  };
+
+  /**
+   * @struct IdHash
+   * @brief Hash that looks up sessions by string_view without copying
+   */
+  struct IdHash {
+    using is_transparent = void;
+
+    [[nodiscard]] size_t operator()(const std::string_view id) const {
+      return std::hash<std::string_view>{}(id);
+    }
+  };
+
+  using SessionMap = std::unordered_map<std::string, Session, IdHash,
+                                        std::equal_to<>>; ///< Sessions by id
+
+  /**
+   * @brief Start or restart a session and send its first guess
+   * @param id The session id
+   * @param strategyKey Key of the strategy to play with
+   * @param replies Buffer the reply is appended to
+   */
+  void startSession(std::string_view id, std::string_view strategyKey,
+                    std::string& replies);
+
+  /**
+   * @brief Apply feedback to a session and send its next guess
+   * @param id The session id
+   * @param feedback Feedback text such as "1A2B"
+   * @param replies Buffer the reply is appended to
+   */
+  void applyFeedback(std::string_view id, std::string_view feedback,
+                     std::string& replies);
+
+  /**
+   * @brief Ask a session's solver for its next guess and send it
+   * @param session The session, which is erased if no guess can be made
+   * @param replies Buffer the reply is appended to
+   */
+  void sendGuess(SessionMap::iterator session, std::string& replies);
+
+  SessionMap m_sessions; ///< Open sessions by id
+  std::vector<std::shared_ptr<const OpeningBook>>
+      m_openingBooks; ///< Books given to every session
+};
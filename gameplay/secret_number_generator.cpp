@@ -2,6 +2,7 @@
 #include "../utils/utils.hpp"
 #include <algorithm>
 #include <array>
+#include <numeric>
 #include <stdexcept>
 
 SecretNumberGenerator::SecretNumberGenerator()
@@ -13,8 +14,9 @@ SecretNumberGenerator& SecretNumberGenerator::getInstance() {
 }
 
 int32_t SecretNumberGenerator::generateSecretNumber() {
-  // Create array of digits 0-9
-  std::array digits{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  // Create array of every digit of the alphabet
+  std::array<int32_t, utils::alphabetSize> digits{};
+  std::iota(digits.begin(), digits.end(), 0);
 
   // Shuffle the digits
   std::ranges::shuffle(digits, m_generator);
@@ -22,7 +24,7 @@ int32_t SecretNumberGenerator::generateSecretNumber() {
   // Ensure first digit is not 0
   if (digits.at(0) == 0) {
     // Find first non-zero digit and swap
-    for (int32_t i{1}; i < 10; ++i) {
+    for (int32_t i{1}; i < utils::alphabetSize; ++i) {
       if (digits.at(i) != 0) {
         std::swap(digits.at(0), digits.at(i));
         break;
@@ -33,7 +35,7 @@ int32_t SecretNumberGenerator::generateSecretNumber() {
   // Build the number
   int32_t secret{0};
   for (int32_t i{0}; i < utils::numberSize; ++i) {
-    secret = secret * 10 + digits.at(i);
+    secret = secret * utils::alphabetSize + digits.at(i);
   }
 
   // Validate the generated number
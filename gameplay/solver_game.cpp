@@ -1,14 +1,31 @@
 #include "solver_game.hpp"
+#include "../solver/opening_book.hpp"
 #include "../utils/utils.hpp"
 #include "user_interface.hpp"
-#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Get the opening books shipped next to the game, loaded once
+ * @return Books found in the opening_books directory, possibly none
+ */
+const std::vector<std::shared_ptr<const OpeningBook>>& getOpeningBooks() {
+  static const std::vector<std::shared_ptr<const OpeningBook>> books{
+      OpeningBook::loadDirectory("opening_books")};
+  return books;
+}
+
+} // namespace
 
 SolverGame::SolverGame(const int32_t maxAttempts,
                        const HeuristicSolver::GuessStrategy strategy)
     : m_solver{strategy}, m_maxAttempts{maxAttempts},
-      m_attemptsLeft{maxAttempts} {}
+      m_attemptsLeft{maxAttempts} {
+  configureSolver(0);
+}
 
 void SolverGame::start() {
   bool shouldRestart{true};
@@ -49,7 +66,7 @@ void SolverGame::start() {
         }
 
         // Parse feedback
-        const auto feedback{parseFeedback(feedbackInput)};
+        const auto feedback{utils::parseFeedback(feedbackInput)};
         if (!feedback.has_value()) {
           UserInterface::displayInvalidFeedback();
           continue;
@@ -86,49 +103,23 @@ void SolverGame::start() {
 }
 
 void SolverGame::reset() {
+  const size_t workerCount{m_solver.getWorkerCount()};
   m_solver = HeuristicSolver{m_solver.getStrategy()};
+  configureSolver(workerCount);
   m_attemptsLeft = m_maxAttempts;
   m_guessCount = 0;
   UserInterface::displaySolverReset();
 }
 
-std::optional<std::pair<int32_t, int32_t>>
-SolverGame::parseFeedback(const std::string_view input) {
-  if (input.length() < 3) { // Minimum: "0a0b" or "0A0B"
-    return std::nullopt;
-  }
-
-  // Convert to lowercase for easier parsing
-  std::string lowerInput{input};
-  std::ranges::transform(lowerInput, lowerInput.begin(), tolower);
-
-  // Find 'a' and 'b' positions
-  const size_t aPos{lowerInput.find('a')};
-  const size_t bPos{lowerInput.find('b')};
-
-  if (aPos == std::string::npos || bPos == std::string::npos || aPos >= bPos) {
-    return std::nullopt;
-  }
-
-  // Extract A count (digit before 'a')
-  if (aPos == 0 || !std::isdigit(lowerInput.at(aPos - 1))) {
-    return std::nullopt;
-  }
-  int32_t aCount{lowerInput.at(aPos - 1) - '0'};
-
-  // Extract B count (digit before 'b')
-  if (bPos == 0 || !std::isdigit(lowerInput.at(bPos - 1))) {
-    return std::nullopt;
-  }
-  int32_t bCount{lowerInput.at(bPos - 1) - '0'};
-
-  // Validate ranges
-  if (aCount < 0 || aCount > 4 || bCount < 0 || bCount > 4 ||
-      aCount + bCount > 4) {
-    return std::nullopt;
+void SolverGame::configureSolver(const size_t workerCount) {
+  // The solver's guesses do not depend on the worker count
+  m_solver.setWorkerCount(workerCount);
+  for (const auto& book : getOpeningBooks()) {
+    m_solver.addOpeningBook(book);
   }
 
-  return std::make_pair(aCount, bCount);
+  // Prepare the follow-up guesses while the player works out the feedback
+  m_solver.setSpeculation(true);
 }
 
 std::string
@@ -142,6 +133,10 @@ SolverGame::getStrategyName(const HeuristicSolver::GuessStrategy strategy) {
     return "Frequency-based";
   case HeuristicSolver::GuessStrategy::hybrid:
     return "Hybrid";
+  case HeuristicSolver::GuessStrategy::optimal:
+    return "Optimal";
+  case HeuristicSolver::GuessStrategy::worstCase:
+    return "Worst-case";
   default:
     return "Unknown";
   }
@@ -44,10 +44,8 @@ private:
   int32_t m_guessCount{0};
 
   /**
-   * @brief Parse user feedback input (e.g., "2A1B", "2a1b")
-   * @param input The user's feedback string
-   * @return Pair of (A count, B count), or nullopt if invalid
+   * @brief Apply the worker count and opening books to a fresh solver
+   * @param workerCount Threads used to score guesses, 0 for all
    */
-  static std::optional<std::pair<int32_t, int32_t>>
-  parseFeedback(std::string_view input);
+  void configureSolver(size_t workerCount);
 };
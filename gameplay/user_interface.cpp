@@ -73,14 +73,16 @@ void UserInterface::displaySolverStrategySelection() {
                   "2. Minimax (Worst-case Optimization)\n"
                   "3. Frequency-based (Statistical)\n"
                   "4. Hybrid (Combines all strategies)\n"
-                  "Enter your choice (1-4): ")};
+                  "5. Optimal (Exhaustive game-tree search)\n"
+                  "6. Worst-case (Fewest guesses guaranteed)\n"
+                  "Enter your choice (1-6): ")};
   std::cout << message;
 }
 
 int32_t UserInterface::getSolverStrategyChoice() {
   return InputValidator::getIntegerInRange(
-             1, 4, "Invalid choice. Please enter a number (1-4): ") -
-         1; // Convert 1-4 to 0-3
+             1, 6, "Invalid choice. Please enter a number (1-6): ") -
+         1; // Convert 1-6 to 0-5
 }
 
 void UserInterface::displaySolverStart(std::string_view strategy,
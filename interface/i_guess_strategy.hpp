@@ -5,10 +5,17 @@
 
 #pragma once
 
-#include <string>
+#include "../utils/number_universe.hpp"
+#include "../utils/parallel.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <vector>
 
-// Forward declaration
+// Forward declarations
+class CandidateView;
 class GuessHistoryManager;
 
 /**
@@ -20,6 +27,18 @@ class GuessHistoryManager;
  */
 class IGuessStrategy {
 public:
+  /**
+   * @struct Selection
+   * @brief Outcome of a selection bounded by a deadline
+   */
+  struct Selection {
+    int32_t guess;               ///< Best guess found
+    bool exact;                  ///< Whether the scan ran to completion
+    std::optional<double> score; ///< Score of guess, if guesses are scored
+    std::vector<utils::Rank>
+        leaders; ///< Ranks of the best guesses, best first
+  };
+
   /**
    * @brief Virtual destructor
    */
@@ -28,22 +47,83 @@ public:
   /**
    * @brief Select the best guess based on the current possible numbers and
    * history
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @param history Reference to the guess history manager for accessing
    * previous guesses
    * @return The best guess according to this strategy
    */
   [[nodiscard]] virtual int32_t
-  selectBestGuess(const std::vector<int32_t>& possibleNumbers,
+  selectBestGuess(const CandidateView& candidates,
                   const GuessHistoryManager& history) const = 0;
 
+  /**
+   * @brief Select a guess, scoring the most promising guesses first and
+   * stopping once a deadline has passed
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager for accessing
+   * previous guesses
+   * @param preferred Ranks of guesses to score first, such as the leaders of
+   * the previous selection
+   * @param deadline No further guesses are scored once it has passed
+   * @return The best guess scored, whether it is the guess selectBestGuess
+   * returns, and the ranks of the leading guesses
+   *
+   * Strategies that cannot stop early run to completion and return an exact
+   * selection without leaders.
+   */
+  [[nodiscard]] virtual Selection
+  selectGuessBefore(const CandidateView& candidates,
+                    const GuessHistoryManager& history,
+                    std::span<const utils::Rank> /*preferred*/,
+                    utils::Deadline /*deadline*/) const {
+    return {selectBestGuess(candidates, history), true, std::nullopt, {}};
+  }
+
   /**
    * @brief Get the name of this strategy
    * @return A string identifying this strategy
    */
   [[nodiscard]] virtual std::string_view getStrategyName() const = 0;
 
+  /**
+   * @brief Set the number of threads used to score potential guesses
+   * @param workerCount Number of workers, 0 for one per hardware thread
+   *
+   * Selections are identical for every worker count.
+   */
+  void setWorkerCount(const size_t workerCount) {
+    m_workerCount = utils::resolveWorkerCount(workerCount);
+  }
+
+  /**
+   * @brief Get the number of threads used to score potential guesses
+   * @return Number of workers, at least 1
+   */
+  [[nodiscard]] size_t getWorkerCount() const { return m_workerCount; }
+
 protected:
+  static constexpr size_t leaderCount{8}; ///< Leaders kept by a selection
+
+  /**
+   * @brief Turn a ranked scan of guess ranks into a selection
+   * @param scan Result of utils::parallelRankUntil over guess ranks
+   * @param fallback Guess to make if no guess was scored
+   * @return Selection led by the best-scoring guess
+   */
+  template <typename Score>
+  [[nodiscard]] static Selection
+  toSelection(const utils::RankedScan<Score>& scan, const int32_t fallback) {
+    Selection selection{fallback, scan.complete, std::nullopt, {}};
+    if (!scan.leaders.empty()) {
+      selection.guess = utils::unrank(scan.leaders.front().index);
+      selection.score = static_cast<double>(scan.leaders.front().score);
+    }
+    for (const auto& leader : scan.leaders) {
+      selection.leaders.push_back(static_cast<utils::Rank>(leader.index));
+    }
+    return selection;
+  }
+
   /**
    * @brief Protected default constructor to prevent direct instantiation
    */
@@ -68,4 +148,6 @@ protected:
    * @brief Protected move assignment operator
    */
   IGuessStrategy& operator=(IGuessStrategy&&) = default;
+
+  size_t m_workerCount{1}; ///< Threads used by selectBestGuess
 };
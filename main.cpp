@@ -1,12 +1,25 @@
 #include "gameplay/game_manager.hpp"
+#include "gameplay/protocol_server.hpp"
 #include <exception>
 #include <iostream>
+#include <string_view>
 
 /**
  * @brief Main entry point for 1A2B game
+ *
+ * With --protocol the interactive game is replaced by the line protocol of
+ * ProtocolServer on stdin and stdout, for driving the solver from scripts.
  */
-int main() {
+int main(const int argc, char** argv) {
   try {
+    if (argc > 1 && std::string_view{argv[1]} == "--protocol") {
+      // Requests are read in bulk rather than line by line from the C stream
+      std::ios::sync_with_stdio(false);
+      std::cin.tie(nullptr);
+      ProtocolServer::run(std::cin, std::cout);
+      return 0;
+    }
+
     GameManager::run();
     return 0;
   } catch (const std::exception& e) {
@@ -0,0 +1,130 @@
+/**
+ * @file bit_sliced_universe.cpp
+ * @brief Implementation of BitSlicedUniverse class
+ */
+
+#include "bit_sliced_universe.hpp"
+#include "../utils/number_universe.hpp"
+#include <bit>
+
+namespace {
+
+using Word = NumberSet::Word;
+
+/**
+ * @brief Add one bit per number to a bit-sliced counter
+ * @param planes Binary digits of the counts, least significant first
+ * @param bits Numbers whose count goes up by one
+ */
+template <size_t PlaneCount>
+constexpr void addBits(std::array<Word, PlaneCount>& planes, Word bits) {
+  for (Word& plane : planes) {
+    const Word carry{plane & bits};
+    plane ^= bits;
+    bits = carry;
+  }
+}
+
+/**
+ * @brief Select the numbers whose bit-sliced count equals a value
+ * @param planes Binary digits of the counts, least significant first
+ * @param value The count to select
+ * @return Bits of the numbers with that count
+ */
+template <size_t PlaneCount>
+constexpr Word equalTo(const std::array<Word, PlaneCount>& planes,
+                       const size_t value) {
+  Word result{~Word{0}};
+  for (size_t plane{0}; plane < PlaneCount; ++plane) {
+    result &= ((value >> plane) & 1U) != 0 ? planes[plane] : ~planes[plane];
+  }
+  return result;
+}
+
+} // namespace
+
+const BitSlicedUniverse& BitSlicedUniverse::getInstance() {
+  static const BitSlicedUniverse instance{};
+  return instance;
+}
+
+BitSlicedUniverse::BitSlicedUniverse() {
+  for (size_t rank{0}; rank < utils::validNumberCount; ++rank) {
+    const auto digits{utils::getDigits(utils::validNumbers[rank])};
+    for (size_t position{0}; position < digits.size(); ++position) {
+      m_positionDigits[position][static_cast<size_t>(digits[position])].set(
+          rank);
+      m_digits[static_cast<size_t>(digits[position])].set(rank);
+    }
+  }
+}
+
+bool BitSlicedUniverse::isSliceable(const int32_t guess) {
+  // Distinct digits bound the number by the largest valid one
+  return guess >= 0 && guess <= utils::maxValidNumber &&
+         std::popcount(utils::digitMask(guess)) == utils::numberSize;
+}
+
+BitSlicedUniverse::WordCounts BitSlicedUniverse::countWord(
+    const std::array<int32_t, utils::numberSize>& digits,
+    const size_t word) const {
+  WordCounts counts{};
+  for (size_t position{0}; position < digits.size(); ++position) {
+    const auto digit{static_cast<size_t>(digits[position])};
+    addBits(counts.exact, m_positionDigits[position][digit].words()[word]);
+    addBits(counts.common, m_digits[digit].words()[word]);
+  }
+  return counts;
+}
+
+NumberSet BitSlicedUniverse::consistentWith(const int32_t guess,
+                                            const int32_t aCount,
+                                            const int32_t bCount) const {
+  if (aCount < 0 || bCount < 0 || aCount + bCount > utils::numberSize) {
+    return {};
+  }
+
+  const auto digits{utils::getDigits(guess)};
+  const NumberSet universe{NumberSet::all()};
+  std::array<Word, NumberSet::wordCount> words{};
+  for (size_t word{0}; word < NumberSet::wordCount; ++word) {
+    const WordCounts counts{countWord(digits, word)};
+    words[word] = equalTo(counts.exact, static_cast<size_t>(aCount)) &
+                  equalTo(counts.common, static_cast<size_t>(aCount + bCount)) &
+                  universe.words()[word];
+  }
+  return NumberSet::fromWords(words);
+}
+
+BitSlicedUniverse::Counts
+BitSlicedUniverse::countFeedback(const int32_t guess,
+                                 const NumberSet& candidates) const {
+  const auto digits{utils::getDigits(guess)};
+  Counts result{};
+  for (size_t word{0}; word < NumberSet::wordCount; ++word) {
+    const Word members{candidates.words()[word]};
+    if (members == 0) {
+      continue;
+    }
+
+    const WordCounts counts{countWord(digits, word)};
+    std::array<Word, utils::numberSize + 1> common{};
+    for (size_t total{0}; total < common.size(); ++total) {
+      common[total] = equalTo(counts.common, total) & members;
+    }
+
+    // Each part is one exact count intersected with one common count
+    for (int32_t aCount{0}; aCount <= utils::numberSize; ++aCount) {
+      const Word exact{equalTo(counts.exact, static_cast<size_t>(aCount))};
+      for (int32_t bCount{0}; aCount + bCount <= utils::numberSize; ++bCount) {
+        // Most parts are empty within a word, and popcount may be a call
+        const Word part{exact & common[static_cast<size_t>(aCount + bCount)]};
+        if (part != 0) {
+          result[utils::encodeFeedback(aCount, bCount)] +=
+              static_cast<uint32_t>(std::popcount(part));
+        }
+      }
+    }
+  }
+  return result;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file bit_sliced_universe.hpp
+ * @brief Digit masks over all valid numbers for word-parallel feedback
+ */
+
+#pragma once
+
+#include "../utils/utils.hpp"
+#include "number_set.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class BitSlicedUniverse
+ * @brief Computes the feedback of a guess against 64 numbers per word
+ *
+ * The universe is stored bit-sliced: one mask per (position, digit) holding
+ * the numbers with that digit at that position, and one mask per digit holding
+ * the numbers containing it. For a guess with distinct digits, a number's A
+ * count is how many of the guess's (position, digit) masks contain it, and its
+ * A + B count is how many of the guess's digit masks do. Both counts are
+ * summed for a whole word of numbers at once with bitwise adders into binary
+ * planes, so a feedback's consistent set, or a partition of the candidates,
+ * takes a fixed number of word operations per 64 numbers and no per-number
+ * work.
+ *
+ * Unlike a table with a mask per guess and feedback, the masks take
+ * (numberSize + 1) * alphabetSize bitsets in total, and guesses outside the
+ * universe (such as numbers with a leading zero) are handled alike as long as
+ * their digits are distinct.
+ */
+class BitSlicedUniverse {
+public:
+  using Counts = std::array<uint32_t, utils::feedbackCodeCount>; ///< By code
+
+  /**
+   * @brief Get the process-wide masks, building them on first use
+   * @return Reference to the shared masks
+   */
+  [[nodiscard]] static const BitSlicedUniverse& getInstance();
+
+  BitSlicedUniverse(const BitSlicedUniverse&) = delete;
+  BitSlicedUniverse& operator=(const BitSlicedUniverse&) = delete;
+
+  /**
+   * @brief Check whether a guess can be scored from the masks
+   * @param guess The guess to check
+   * @return true if the guess has numberSize distinct digits, counting
+   * leading zeros
+   */
+  [[nodiscard]] static bool isSliceable(int32_t guess);
+
+  /**
+   * @brief Get the numbers with a digit at a position
+   * @param position Digit position, 0 being the most significant
+   * @param digit The digit
+   * @return Mask of the numbers by rank
+   */
+  [[nodiscard]] const NumberSet& withDigitAt(const size_t position,
+                                             const int32_t digit) const {
+    return m_positionDigits[position][static_cast<size_t>(digit)];
+  }
+
+  /**
+   * @brief Get the numbers containing a digit
+   * @param digit The digit
+   * @return Mask of the numbers by rank
+   */
+  [[nodiscard]] const NumberSet& withDigit(const int32_t digit) const {
+    return m_digits[static_cast<size_t>(digit)];
+  }
+
+  /**
+   * @brief Get the numbers that give a specific feedback to a guess
+   * @param guess The guess (must be sliceable)
+   * @param aCount Number of correct digits in correct positions
+   * @param bCount Number of correct digits in wrong positions
+   * @return Mask of the consistent numbers
+   */
+  [[nodiscard]] NumberSet consistentWith(int32_t guess, int32_t aCount,
+                                         int32_t bCount) const;
+
+  /**
+   * @brief Count the candidates giving each feedback to a guess
+   * @param guess The guess (must be sliceable)
+   * @param candidates The numbers to partition
+   * @return Candidates per feedback code, as utils::encodeFeedback
+   */
+  [[nodiscard]] Counts countFeedback(int32_t guess,
+                                     const NumberSet& candidates) const;
+
+private:
+  static constexpr size_t planeCount{static_cast<size_t>(
+      std::bit_width(static_cast<uint32_t>(utils::numberSize)))}; ///< Bits
+
+  using Planes =
+      std::array<NumberSet::Word, planeCount>; ///< Binary digits of a count
+
+  /**
+   * @struct WordCounts
+   * @brief Match counts of the numbers of one word against a guess
+   */
+  struct WordCounts {
+    Planes exact;  ///< Digits at the right position (the A count)
+    Planes common; ///< Digits in common (the A + B count)
+  };
+
+  /**
+   * @brief Private constructor that builds the masks
+   */
+  BitSlicedUniverse();
+
+  /**
+   * @brief Sum the guess's masks over one word of numbers
+   * @param digits Digits of the guess, most significant first
+   * @param word Index of the word
+   * @return Bit-sliced counts of that word
+   */
+  [[nodiscard]] WordCounts
+  countWord(const std::array<int32_t, utils::numberSize>& digits,
+            size_t word) const;
+
+  std::array<std::array<NumberSet, utils::alphabetSize>, utils::numberSize>
+      m_positionDigits; ///< Numbers by (position, digit)
+  std::array<NumberSet, utils::alphabetSize>
+      m_digits; ///< Numbers by digit present
+};
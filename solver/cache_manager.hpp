@@ -5,67 +5,147 @@
 
 #pragma once
 
+#include "../utils/number_universe.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
-#include <unordered_map>
+#include <utility>
 
 /**
  * @class CacheManager
  * @brief Template class for managing calculation caches
  * @tparam T The type of values to cache
+ *
+ * Entries are keyed by the dense rank of the evaluated guess (utils::rank), so
+ * the cache is a flat array with one slot per valid number and a lookup is a
+ * single indexed load. Each slot records the generation it was written in;
+ * clear() starts a new generation, which empties the cache without touching
+ * the slots.
+ *
+ * Slots of distinct keys never share state, so different threads may cache
+ * different keys at the same time, as long as no thread reads a key while
+ * another writes it.
  */
 template <typename T> class CacheManager {
 public:
+  static constexpr size_t capacity{
+      static_cast<size_t>(utils::validNumberCount)}; ///< One slot per rank
+  static constexpr size_t cacheLineSize{64}; ///< Alignment of the slot array
+
   /**
    * @brief Default constructor
    */
-  CacheManager() = default;
+  CacheManager() : m_storage{std::make_unique<Storage>()} {}
+
+  CacheManager(const CacheManager&) = delete;
+  CacheManager& operator=(const CacheManager&) = delete;
+
+  /**
+   * @brief Move constructor
+   *
+   * The slots are taken over and other is left with fresh, empty ones, so
+   * a moved-from cache stays usable.
+   */
+  CacheManager(CacheManager&& other)
+      : m_storage{std::exchange(other.m_storage, std::make_unique<Storage>())},
+        m_generation{std::exchange(other.m_generation, 1)} {}
+
+  /**
+   * @brief Move assignment operator; exchanges the slots of both caches
+   * @return Reference to this cache
+   */
+  CacheManager& operator=(CacheManager&& other) noexcept {
+    std::swap(m_storage, other.m_storage);
+    std::swap(m_generation, other.m_generation);
+    return *this;
+  }
+
+  ~CacheManager() = default;
 
   /**
    * @brief Cache a value with the given key
-   * @param key The key to associate with the value
+   * @param key The guess rank to associate with the value; keys outside
+   * [0, capacity) are ignored
    * @param value The value to cache
    */
-  void cache(int32_t key, const T& value) { m_cache[key] = value; }
+  void cache(const size_t key, const T& value) {
+    if (key < capacity) {
+      m_storage->slots[key] = Slot{value, m_generation};
+    }
+  }
 
   /**
    * @brief Retrieve a cached value by key
    * @param key The key to look up
    * @return The cached value if found, nullopt otherwise
    */
-  [[nodiscard]] std::optional<T> get(int32_t key) const {
-    if (const auto it{m_cache.find(key)}; it != m_cache.end()) {
-      return it->second;
+  [[nodiscard]] std::optional<T> get(const size_t key) const {
+    if (!contains(key)) {
+      return std::nullopt;
     }
-    return std::nullopt;
+    return m_storage->slots[key].value;
   }
 
   /**
    * @brief Clear all cached values
+   *
+   * Runs in constant time, except once every 2^32 calls when the generation
+   * counter wraps and every slot is reset.
    */
-  void clear() { m_cache.clear(); }
+  void clear() {
+    if (++m_generation == 0) {
+      std::ranges::fill(m_storage->slots, Slot{});
+      m_generation = 1;
+    }
+  }
 
   /**
    * @brief Check if a key exists in the cache
    * @param key The key to check
    * @return true if the key exists in the cache, false otherwise
    */
-  [[nodiscard]] bool contains(int32_t key) const {
-    return m_cache.contains(key);
+  [[nodiscard]] bool contains(const size_t key) const {
+    return key < capacity && m_storage->slots[key].generation == m_generation;
   }
 
   /**
    * @brief Get the number of cached entries
    * @return The size of the cache
+   * @note Counts the slots of the current generation, so it takes time
+   * proportional to capacity
    */
-  [[nodiscard]] size_t size() const { return m_cache.size(); }
+  [[nodiscard]] size_t size() const {
+    return static_cast<size_t>(
+        std::ranges::count(m_storage->slots, m_generation, &Slot::generation));
+  }
 
   /**
    * @brief Check if the cache is empty
    * @return true if the cache is empty, false otherwise
    */
-  [[nodiscard]] bool empty() const { return m_cache.empty(); }
+  [[nodiscard]] bool empty() const { return size() == 0; }
 
 private:
-  mutable std::unordered_map<int32_t, T>
-      m_cache; ///< The underlying cache storage
+  /**
+   * @struct Slot
+   * @brief Cached value of one key
+   */
+  struct Slot {
+    T value{};              ///< The cached value
+    uint32_t generation{0}; ///< Generation it was cached in, 0 if never
+  };
+
+  /**
+   * @struct Storage
+   * @brief Slot array aligned to a cache line
+   */
+  struct alignas(cacheLineSize) Storage {
+    std::array<Slot, capacity> slots{}; ///< Slot per rank
+  };
+
+  std::unique_ptr<Storage> m_storage; ///< Slots; on the heap for cheap moves
+  uint32_t m_generation{1};           ///< Generation of current entries
 };
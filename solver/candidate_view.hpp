@@ -0,0 +1,105 @@
+/**
+ * @file candidate_view.hpp
+ * @brief Non-owning view over the numbers still considered possible
+ */
+
+#pragma once
+
+#include "../utils/number_universe.hpp"
+#include "number_set.hpp"
+#include <cstdint>
+#include <span>
+
+/**
+ * @class CandidateView
+ * @brief Read-only view of a search space handed to guess strategies
+ *
+ * The view never copies the candidates. It always references the membership
+ * bitset and may additionally reference a dense, ascending list of member
+ * ranks maintained by the owner; when present, iteration walks that
+ * contiguous list instead of scanning bitset words.
+ */
+class CandidateView {
+public:
+  /**
+   * @brief Construct a view over a bitset only
+   * @param set The membership bitset (must outlive the view)
+   */
+  explicit CandidateView(const NumberSet& set)
+      : m_set{&set}, m_size{set.count()} {}
+
+  /**
+   * @brief Construct a view over a bitset and its dense rank list
+   * @param set The membership bitset (must outlive the view)
+   * @param ranks Ascending ranks of the members of set (must outlive the view)
+   */
+  CandidateView(const NumberSet& set, const std::span<const utils::Rank> ranks)
+      : m_set{&set}, m_ranks{ranks}, m_size{ranks.size()}, m_dense{true} {}
+
+  /**
+   * @brief Get the number of candidates
+   * @return Count of possible numbers
+   */
+  [[nodiscard]] size_t size() const { return m_size; }
+
+  /**
+   * @brief Check if there are no candidates
+   * @return true if no number is possible
+   */
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+
+  /**
+   * @brief Check whether a number is a candidate
+   * @param rank Rank of the number
+   * @return true if the number is still possible
+   */
+  [[nodiscard]] bool contains(const size_t rank) const {
+    return m_set->test(rank);
+  }
+
+  /**
+   * @brief Get the smallest candidate
+   * @return The smallest possible number (view must not be empty)
+   */
+  [[nodiscard]] int32_t front() const {
+    return utils::unrank(m_dense ? m_ranks.front() : *m_set->begin());
+  }
+
+  /**
+   * @brief Check if the dense rank list is available
+   * @return true if ranks() lists every candidate
+   */
+  [[nodiscard]] bool hasDenseRanks() const { return m_dense; }
+
+  /**
+   * @brief Get the dense rank list
+   * @return Ascending ranks of all candidates, empty if not maintained
+   */
+  [[nodiscard]] std::span<const utils::Rank> ranks() const { return m_ranks; }
+
+  /**
+   * @brief Get the membership bitset
+   * @return Reference to the underlying set
+   */
+  [[nodiscard]] const NumberSet& set() const { return *m_set; }
+
+  /**
+   * @brief Invoke a function on every candidate rank in ascending order
+   * @param fn Callable taking a size_t rank
+   */
+  template <typename Fn> void forEach(Fn&& fn) const {
+    if (m_dense) {
+      for (const utils::Rank rank : m_ranks) {
+        fn(static_cast<size_t>(rank));
+      }
+    } else {
+      m_set->forEach(fn);
+    }
+  }
+
+private:
+  const NumberSet* m_set;                 ///< Membership bitset
+  std::span<const utils::Rank> m_ranks{}; ///< Optional dense rank list
+  size_t m_size{0};                       ///< Number of candidates
+  bool m_dense{false};                    ///< Whether m_ranks is populated
+};
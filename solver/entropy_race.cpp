@@ -0,0 +1,139 @@
+/**
+ * @file entropy_race.cpp
+ * @brief Implementation of EntropyRace class
+ */
+
+#include "entropy_race.hpp"
+#include "../utils/parallel.hpp"
+#include "../utils/utils.hpp"
+#include "feedback_table.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <random>
+
+namespace {
+
+using CodeCounts =
+    std::array<uint32_t, utils::feedbackCodeCount>; ///< Sample part sizes
+
+/**
+ * @struct Estimate
+ * @brief Entropy of a guess estimated from a sample
+ */
+struct Estimate {
+  double entropy;   ///< Bias-corrected estimate in bits
+  double halfWidth; ///< Half-width of the confidence interval
+};
+
+/**
+ * @brief Estimate the entropy of a partition from its sampled part sizes
+ * @param counts Sampled secrets per feedback code
+ * @param sampled Number of sampled secrets
+ * @param population Number of candidates the sample was drawn from
+ * @param confidence Interval half-width in standard errors
+ * @return Estimate and confidence interval
+ */
+Estimate estimate(const CodeCounts& counts, const size_t sampled,
+                  const size_t population, const double confidence) {
+  const auto sampleSize{static_cast<double>(sampled)};
+  double entropy{0.0};
+  double secondMoment{0.0};
+  size_t parts{0};
+  for (const uint32_t count : counts) {
+    if (count > 0) {
+      const double probability{static_cast<double>(count) / sampleSize};
+      const double information{std::log2(probability)};
+      entropy -= probability * information;
+      secondMoment += probability * information * information;
+      ++parts;
+    }
+  }
+
+  // Drawing without replacement leaves less to learn about the rest of the
+  // space; at a full sample the estimate is exact
+  const double unsampled{
+      population > 1 ? static_cast<double>(population - sampled) /
+                           static_cast<double>(population - 1)
+                     : 0.0};
+
+  // The variance is that of the information -log2(p) of one secret
+  const double variance{std::max(secondMoment - entropy * entropy, 0.0) /
+                        sampleSize * unsampled};
+
+  // Miller-Madow: a sample misses small parts, which biases entropy low
+  const double bias{static_cast<double>(parts - 1) /
+                    (2.0 * sampleSize * std::numbers::ln2) * unsampled};
+
+  return {entropy + bias, confidence * std::sqrt(variance)};
+}
+
+} // namespace
+
+EntropyRace::EntropyRace(const CandidateView& candidates,
+                         const EntropySampling& sampling)
+    : m_sampling{sampling} {
+  m_sample.reserve(candidates.size());
+  candidates.forEach([this](const size_t rank) {
+    m_sample.push_back(static_cast<utils::Rank>(rank));
+  });
+
+  // Shuffling once makes every prefix a uniform sample
+  std::mt19937_64 engine{m_sampling.seed ^ m_sample.size()};
+  std::ranges::shuffle(m_sample, engine);
+}
+
+std::vector<utils::Rank>
+EntropyRace::run(const std::span<const utils::Rank> guessRanks,
+                 const size_t workerCount) const {
+  const FeedbackTable& table{FeedbackTable::getInstance()};
+  const size_t population{m_sample.size()};
+  const size_t finalists{std::max<size_t>(m_sampling.finalists, 1)};
+
+  std::vector<utils::Rank> active(guessRanks.begin(), guessRanks.end());
+  std::vector<CodeCounts> counts(active.size());
+  std::vector<Estimate> estimates(active.size());
+
+  // A sample as large as the space costs as much as an exact evaluation of
+  // the survivors, so the race stops short of it and leaves them to that
+  size_t sampled{0};
+  size_t target{std::max<size_t>(m_sampling.initialSample, 1)};
+  while (active.size() > finalists && target < population) {
+    // Extend every survivor's histogram with the newly sampled secrets
+    utils::parallelFor(
+        active.size(), workerCount,
+        [&](size_t, const size_t begin, const size_t end) {
+          for (size_t i{begin}; i < end; ++i) {
+            for (size_t s{sampled}; s < target; ++s) {
+              ++counts[i][table.code(active[i], m_sample[s])];
+            }
+            estimates[i] = estimate(counts[i], target, population,
+                                    m_sampling.confidence);
+          }
+        });
+    sampled = target;
+    target = sampled * 2;
+
+    double bestLower{std::numeric_limits<double>::lowest()};
+    for (const Estimate& guess : estimates) {
+      bestLower = std::max(bestLower, guess.entropy - guess.halfWidth);
+    }
+
+    size_t kept{0};
+    for (size_t i{0}; i < active.size(); ++i) {
+      if (estimates[i].entropy + estimates[i].halfWidth >= bestLower) {
+        active[kept] = active[i];
+        counts[kept] = counts[i];
+        estimates[kept] = estimates[i];
+        ++kept;
+      }
+    }
+    active.resize(kept);
+    counts.resize(kept);
+    estimates.resize(kept);
+  }
+
+  return active;
+}
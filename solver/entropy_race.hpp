@@ -0,0 +1,68 @@
+/**
+ * @file entropy_race.hpp
+ * @brief Sampled entropy estimates that race guesses against each other
+ */
+
+#pragma once
+
+#include "candidate_view.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @struct EntropySampling
+ * @brief Settings of the approximate entropy mode
+ */
+struct EntropySampling {
+  size_t minCandidates{1024}; ///< Smaller search spaces are scored exactly
+  size_t initialSample{128};  ///< Secrets in the first sample
+  size_t finalists{4};        ///< Contenders that get an exact evaluation
+  double confidence{3.0};     ///< Interval half-width in standard errors
+  uint64_t seed{0x1A2B};      ///< Seed of the sample; equal seeds, equal draws
+};
+
+/**
+ * @class EntropyRace
+ * @brief Narrows the guesses down to those whose entropy may be the highest
+ *
+ * Instead of partitioning every candidate for every guess, each guess is
+ * scored on a random sample of the candidates. Every guess sees the same
+ * sample, so sampling noise affects all of them alike. The entropy of the
+ * sampled partition, with the Miller-Madow bias correction, estimates the
+ * entropy of the full partition, and its standard error gives each guess a
+ * confidence interval. A guess whose interval ends below the lower end of
+ * the best guess's interval is dropped.
+ *
+ * The sample doubles each round and only the surviving guesses are extended,
+ * until few enough survive or the next sample would cover every candidate.
+ * Sampling is without replacement, so the intervals narrow faster than for
+ * an unbounded population as the sample grows towards the whole space.
+ *
+ * The sample is drawn from a generator seeded with EntropySampling::seed and
+ * the candidate count, so a position always yields the same survivors,
+ * whatever the worker count.
+ */
+class EntropyRace {
+public:
+  /**
+   * @brief Draw the sample for a search space
+   * @param candidates View of the numbers still considered possible
+   * @param sampling Sample sizes, confidence and seed
+   */
+  EntropyRace(const CandidateView& candidates, const EntropySampling& sampling);
+
+  /**
+   * @brief Race guesses on growing samples
+   * @param guessRanks Ranks of the guesses to race
+   * @param workerCount Threads sharing the guesses of each round
+   * @return Ranks of the surviving guesses, in the order given
+   */
+  [[nodiscard]] std::vector<utils::Rank>
+  run(std::span<const utils::Rank> guessRanks, size_t workerCount) const;
+
+private:
+  EntropySampling m_sampling;        ///< Race settings
+  std::vector<utils::Rank> m_sample; ///< Candidate ranks in sampling order
+};
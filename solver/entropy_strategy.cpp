@@ -5,51 +5,103 @@
 
 #include "entropy_strategy.hpp"
 
-#include "../utils/utils.hpp"
+#include "../utils/number_universe.hpp"
+#include "entropy_race.hpp"
 #include "guess_history_manager.hpp"
-#include <cmath>
-#include <map>
-#include <ranges>
+#include "partition.hpp"
+#include "symmetry_reducer.hpp"
+#include "tiled_scorer.hpp"
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 EntropyStrategy::EntropyStrategy(CacheManager<double>& cache)
     : m_cache{cache} {}
 
 int32_t
-EntropyStrategy::selectBestGuess(const std::vector<int32_t>& possibleNumbers,
+EntropyStrategy::selectBestGuess(const CandidateView& candidates,
                                  const GuessHistoryManager& history) const {
+  return selectGuessBefore(candidates, history, {}, utils::Deadline::max())
+      .guess;
+}
+
+IGuessStrategy::Selection EntropyStrategy::selectGuessBefore(
+    const CandidateView& candidates, const GuessHistoryManager& history,
+    const std::span<const utils::Rank> preferred,
+    const utils::Deadline deadline) const {
 
-  if (possibleNumbers.empty()) {
-    return utils::minValidNumber; // Fallback to a known valid number
+  if (candidates.empty()) {
+    // Fallback to a known valid number
+    return {utils::minValidNumber, true, std::nullopt, {}};
   }
 
   // If only one possibility remains, return it
-  if (possibleNumbers.size() == 1) {
-    return possibleNumbers.at(0);
+  if (candidates.size() == 1) {
+    return {candidates.front(), true, std::nullopt, {}};
+  }
+
+  // Consider all unguessed numbers as potential guesses; equivalent guesses
+  // score the same, so only one per symmetry class is evaluated, the most
+  // promising first
+  const SymmetryReducer symmetry{history};
+  auto order{symmetry.getGuessOrder(candidates, preferred)};
+
+  // In a large space, guesses that a sample shows to be clearly worse are
+  // not partitioned in full
+  if (m_sampling.has_value() &&
+      candidates.size() >= m_sampling->minCandidates) {
+    order = EntropyRace{candidates, m_sampling.value()}.run(order,
+                                                            m_workerCount);
   }
 
-  int32_t bestGuess{possibleNumbers.at(0)};
-  double bestEntropy{-1.0};
-
-  // Consider all possible numbers as potential guesses
-  for (size_t i{0}; i < utils::validNumberRange; ++i) {
-    const int32_t candidate{static_cast<int32_t>(i) + utils::minValidNumber};
-    if (!utils::isValidGuess(candidate).has_value()) {
-      continue;
-    }
-
-    // Skip if we've already guessed this number
-    if (history.hasBeenGuessed(candidate)) {
-      continue;
-    }
-
-    if (const double entropy{calculateEntropy(candidate, possibleNumbers)};
-        entropy > bestEntropy) {
-      bestEntropy = entropy;
-      bestGuess = candidate;
-    }
+  // Variants without a feedback table partition a whole block of guesses per
+  // pass over the packed candidates
+  if (TiledScorer::isPreferred(candidates)) {
+    const TiledScorer scorer{candidates};
+    const auto scan{utils::parallelRankBlocksUntil<double>(
+        std::span<const utils::Rank>{order}, m_workerCount, leaderCount,
+        deadline,
+        [&](size_t, const std::span<const utils::Rank> block,
+            const std::span<std::optional<double>> scores) {
+          for (size_t i{0}; i < block.size(); ++i) {
+            scores[i] = m_cache.get(block[i]);
+          }
+          scorer.score(block, scores,
+                       [this](const size_t rank, const Partition& partition) {
+                         const double entropy{partition.entropy()};
+                         m_cache.cache(rank, entropy);
+                         return entropy;
+                       });
+        },
+        std::greater{})};
+    return toSelection(scan, candidates.front());
   }
 
-  return bestGuess;
+  // Every guess is scored by exactly one worker, which alone reads and writes
+  // its cache slot
+  const auto scan{utils::parallelRankUntil(
+      std::span<const utils::Rank>{order}, m_workerCount, leaderCount,
+      deadline,
+      [&](size_t, const size_t rank) -> std::optional<double> {
+        if (const auto cachedValue{m_cache.get(rank)};
+            cachedValue.has_value()) {
+          return cachedValue;
+        }
+
+        const double entropy{Partition{rank, candidates}.entropy()};
+        m_cache.cache(rank, entropy);
+        return entropy;
+      },
+      std::greater{})};
+
+  return toSelection(scan, candidates.front());
+}
+
+void EntropyStrategy::setSampling(
+    const std::optional<EntropySampling>& sampling) {
+  m_sampling = sampling;
 }
 
 std::string_view EntropyStrategy::getStrategyName() const {
@@ -57,37 +109,27 @@ std::string_view EntropyStrategy::getStrategyName() const {
 }
 
 double EntropyStrategy::calculateEntropy(
-    const int32_t guess, const std::vector<int32_t>& possibleNumbers) const {
+    const int32_t guess, const CandidateView& candidates) const {
+
+  const auto guessRank{utils::rank(guess)};
+  if (!guessRank.has_value()) {
+    throw std::invalid_argument("Guess must be a valid number");
+  }
 
   // Check cache first
-  if (const auto cachedValue{m_cache.get(guess)}; cachedValue.has_value()) {
+  if (const auto cachedValue{m_cache.get(guessRank.value())};
+      cachedValue.has_value()) {
     return cachedValue.value();
   }
 
-  if (possibleNumbers.empty()) {
+  if (candidates.empty()) {
     return 0.0;
   }
 
-  // Count frequency of each possible feedback
-  std::map<std::pair<int32_t, int32_t>, size_t> feedbackCounts;
-
-  for (const int32_t target : possibleNumbers) {
-    const auto [aCount, bCount]{utils::calculateAB(guess, target)};
-    ++feedbackCounts[{aCount, bCount}];
-  }
-
-  // Calculate entropy using Shannon's formula: H = -Σ(p * log2(p))
-  double entropy{0.0};
-  const auto totalCount{static_cast<double>(possibleNumbers.size())};
-
-  for (const auto& count : feedbackCounts | std::views::values) {
-    if (count > 0) {
-      const double probability{static_cast<double>(count) / totalCount};
-      entropy -= probability * std::log2(probability);
-    }
-  }
+  // Partition the candidates by feedback and take its Shannon entropy
+  const double entropy{Partition{guessRank.value(), candidates}.entropy()};
 
   // Cache the result
-  m_cache.cache(guess, entropy);
+  m_cache.cache(guessRank.value(), entropy);
   return entropy;
 }
@@ -6,9 +6,12 @@
 #pragma once
 
 #include "../interface/i_guess_strategy.hpp"
+#include "candidate_view.hpp"
 #include "cache_manager.hpp"
+#include "entropy_race.hpp"
 #include <cstdint>
-#include <vector>
+#include <optional>
+#include <span>
 
 /**
  * @class EntropyStrategy
@@ -33,31 +36,66 @@ public:
 
   /**
    * @brief Select the best guess using entropy-based analysis
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @param history Reference to the guess history manager
    * @return The guess that maximizes information gain
    */
   [[nodiscard]] int32_t
-  selectBestGuess(const std::vector<int32_t>& possibleNumbers,
+  selectBestGuess(const CandidateView& candidates,
                   const GuessHistoryManager& history) const override;
 
+  /**
+   * @brief Select a guess, scoring candidates and earlier leaders first
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager
+   * @param preferred Ranks of guesses to score first
+   * @param deadline No further guesses are scored once it has passed
+   * @return The best guess scored before the deadline
+   */
+  [[nodiscard]] Selection
+  selectGuessBefore(const CandidateView& candidates,
+                    const GuessHistoryManager& history,
+                    std::span<const utils::Rank> preferred,
+                    utils::Deadline deadline) const override;
+
   /**
    * @brief Get the name of this strategy
    * @return String identifier for this strategy
    */
   [[nodiscard]] std::string_view getStrategyName() const override;
 
+  /**
+   * @brief Enable or disable approximate entropy in large search spaces
+   * @param sampling Race settings, or nullopt to score every guess exactly
+   *
+   * With sampling, search spaces of at least EntropySampling::minCandidates
+   * numbers are first narrowed down by an EntropyRace, and only its survivors
+   * are scored exactly. The guess may then differ from the exact one, but
+   * only between guesses the race could not tell apart.
+   */
+  void setSampling(const std::optional<EntropySampling>& sampling);
+
+  /**
+   * @brief Get the approximate entropy settings
+   * @return Race settings, or nullopt if every guess is scored exactly
+   */
+  [[nodiscard]] const std::optional<EntropySampling>& getSampling() const {
+    return m_sampling;
+  }
+
   /**
    * @brief Calculate entropy (information gain) for a potential guess
    * @param guess The potential guess to evaluate
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @return Entropy value (higher values indicate better information gain)
    */
   [[nodiscard]] double
   calculateEntropy(int32_t guess,
-                   const std::vector<int32_t>& possibleNumbers) const;
+                   const CandidateView& candidates) const;
 
 private:
   CacheManager<double>&
       m_cache; ///< Reference to cache manager for entropy calculations
+  std::optional<EntropySampling>
+      m_sampling; ///< Race settings, nullopt for exact scoring
 };
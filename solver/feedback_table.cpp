@@ -0,0 +1,41 @@
+/**
+ * @file feedback_table.cpp
+ * @brief Implementation of FeedbackTable class
+ */
+
+#include "feedback_table.hpp"
+#include "../utils/feedback_kernel.hpp"
+
+const FeedbackTable& FeedbackTable::getInstance() {
+  static const FeedbackTable instance{};
+  return instance;
+}
+
+FeedbackTable::FeedbackTable() {
+  if constexpr (!tabulated) {
+    return;
+  }
+
+  m_codes.resize(static_cast<size_t>(utils::validNumberCount) *
+                 utils::validNumberCount);
+
+  // Each row is one batched kernel call over the whole universe
+  for (size_t guess{0}; guess < utils::validNumberCount; ++guess) {
+    utils::computeFeedbackCodes(
+        {utils::packedDigits[guess], utils::digitMasks[guess]},
+        utils::packedDigits, utils::digitMasks,
+        std::span{m_codes}.subspan(guess * utils::validNumberCount,
+                                   utils::validNumberCount));
+  }
+}
+
+uint8_t FeedbackTable::lookup(const int32_t guess, const int32_t target) const {
+  const auto guessRank{utils::rank(guess)};
+  const auto targetRank{utils::rank(target)};
+  if (guessRank.has_value() && targetRank.has_value()) {
+    return code(guessRank.value(), targetRank.value());
+  }
+
+  const auto [aCount, bCount]{utils::calculateAB(guess, target)};
+  return utils::encodeFeedback(aCount, bCount);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file feedback_table.hpp
+ * @brief Precomputed feedback codes for every (guess, target) pair
+ */
+
+#pragma once
+
+#include "../utils/number_universe.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @class FeedbackTable
+ * @brief Dense table of feedback codes between all valid numbers
+ *
+ * Rows and columns are indexed by the dense rank of utils::rank. The table
+ * stores one byte per (guess, target) pair holding utils::encodeFeedback(A, B),
+ * so the solver's inner loops reduce to a single byte load instead of a digit
+ * extraction and comparison per pair. The table is built once per process on
+ * first access and is read-only afterwards.
+ *
+ * The table grows with the square of the universe, so variants with more
+ * than maxTabulatedNumbers numbers are not tabulated: code() then scores the
+ * pair on the fly, and row() is unavailable.
+ */
+class FeedbackTable {
+public:
+  static constexpr size_t maxTabulatedNumbers{
+      8192}; ///< Largest universe tabulated (a 64 MiB table)
+  static constexpr bool tabulated{
+      utils::validNumberCount <=
+      maxTabulatedNumbers}; ///< Whether the variant has a table
+
+  /**
+   * @brief Get the process-wide table, building it on first use
+   * @return Reference to the shared table
+   */
+  [[nodiscard]] static const FeedbackTable& getInstance();
+
+  FeedbackTable(const FeedbackTable&) = delete;
+  FeedbackTable& operator=(const FeedbackTable&) = delete;
+
+  /**
+   * @brief Get the feedback codes of one guess against every valid number
+   * @param guessRank Rank of the guess
+   * @return Row of feedback codes indexed by target rank
+   * @throws std::runtime_error If the variant is not tabulated
+   */
+  [[nodiscard]] std::span<const uint8_t, utils::validNumberCount>
+  row(const size_t guessRank) const {
+    if constexpr (!tabulated) {
+      throw std::runtime_error("Feedback rows need a tabulated variant");
+    }
+    return std::span<const uint8_t, utils::validNumberCount>{
+        m_codes.data() + guessRank * utils::validNumberCount,
+        utils::validNumberCount};
+  }
+
+  /**
+   * @brief Get the feedback code for a pair of ranks
+   * @param guessRank Rank of the guess
+   * @param targetRank Rank of the target
+   * @return Feedback code as produced by utils::encodeFeedback
+   */
+  [[nodiscard]] uint8_t code(const size_t guessRank,
+                             const size_t targetRank) const {
+    if constexpr (tabulated) {
+      return m_codes[guessRank * utils::validNumberCount + targetRank];
+    } else {
+      return static_cast<uint8_t>(utils::Shape::feedbackCode(
+          utils::packedDigits[guessRank], utils::digitMasks[guessRank],
+          utils::packedDigits[targetRank], utils::digitMasks[targetRank]));
+    }
+  }
+
+  /**
+   * @brief Get the feedback code for a pair of numbers
+   * @param guess The guess number
+   * @param target The target number
+   * @return Feedback code as produced by utils::encodeFeedback
+   *
+   * Numbers outside the table fall back to utils::calculateAB.
+   */
+  [[nodiscard]] uint8_t lookup(int32_t guess, int32_t target) const;
+
+private:
+  /**
+   * @brief Private constructor that builds the full table
+   */
+  FeedbackTable();
+
+  std::vector<uint8_t> m_codes; ///< Row-major feedback codes, if tabulated
+};
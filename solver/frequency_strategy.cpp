@@ -5,38 +5,39 @@
 
 #include "frequency_strategy.hpp"
 
-#include "../utils/utils.hpp"
+#include "../utils/number_universe.hpp"
 #include "guess_history_manager.hpp"
+#include "symmetry_reducer.hpp"
 #include <array>
+#include <functional>
+#include <optional>
 
 int32_t FrequencyStrategy::selectBestGuess(
-    const std::vector<int32_t>& possibleNumbers,
-    const GuessHistoryManager& history) const noexcept {
-  if (possibleNumbers.empty()) {
+    const CandidateView& candidates,
+    const GuessHistoryManager& history) const {
+  if (candidates.empty()) {
     return utils::minValidNumber;
   }
-  if (possibleNumbers.size() <= 2) {
-    return possibleNumbers.front();
+  if (candidates.size() <= 2) {
+    return candidates.front();
   }
 
-  int32_t bestGuess{possibleNumbers.front()};
-  double bestScore{-1.0};
+  // Digit counts depend only on the candidates, so build them once
+  const DigitCounts counts{countDigits(candidates)};
 
-  for (size_t i{0}; i < utils::validNumberRange; ++i) {
-    const int32_t candidate{static_cast<int32_t>(i) + utils::minValidNumber};
-    if (!utils::isValidGuess(candidate).has_value() ||
-        history.hasBeenGuessed(candidate)) {
-      continue;
-    }
+  // Equivalent unguessed guesses score the same; evaluate one per class
+  const SymmetryReducer symmetry{history};
+  const auto guessRanks{symmetry.getGuessRanks()};
 
-    if (const double score{calculateFrequency(candidate, possibleNumbers)};
-        score > bestScore) {
-      bestScore = score;
-      bestGuess = candidate;
-    }
-  }
+  const auto best{utils::parallelArgBest(
+      guessRanks.size(), m_workerCount,
+      [&](size_t, const size_t index) -> std::optional<double> {
+        return scoreDigits(guessRanks[index], counts, candidates.size());
+      },
+      std::greater{})};
 
-  return bestGuess;
+  return best.has_value() ? utils::unrank(guessRanks[best->index])
+                          : candidates.front();
 }
 
 std::string_view FrequencyStrategy::getStrategyName() const noexcept {
@@ -44,26 +45,41 @@ std::string_view FrequencyStrategy::getStrategyName() const noexcept {
 }
 
 double FrequencyStrategy::calculateFrequency(
-    int32_t guess,
-    const std::vector<int32_t>& possibleNumbers) const noexcept {
-  if (possibleNumbers.empty()) {
+    int32_t guess, const CandidateView& candidates) const {
+  const auto guessRank{utils::rank(guess)};
+  if (candidates.empty() || !guessRank.has_value()) {
     return 0.0;
   }
 
-  std::array<std::array<int32_t, 10>, utils::numberSize> digitFreq{};
-  for (const auto number : possibleNumbers) {
-    auto digits = utils::getDigits(number);
+  return scoreDigits(guessRank.value(), countDigits(candidates),
+                     candidates.size());
+}
+
+FrequencyStrategy::DigitCounts
+FrequencyStrategy::countDigits(const CandidateView& candidates) const {
+  DigitCounts counts{};
+  candidates.forEach([&counts](const size_t rank) {
+    const uint32_t digits{utils::packedDigits[rank]};
     for (size_t pos{0}; pos < utils::numberSize; ++pos) {
-      ++digitFreq.at(pos).at(digits.at(pos));
+      ++counts[pos][utils::packedDigitAt(digits, pos)];
     }
+  });
+  return counts;
+}
+
+double FrequencyStrategy::scoreDigits(
+    const size_t guessRank, const DigitCounts& counts,
+    const size_t candidateCount) const {
+  if (candidateCount == 0) {
+    return 0.0;
   }
 
-  const double invCount{1.0 / static_cast<double>(possibleNumbers.size())};
-  auto guessDigits{utils::getDigits(guess)};
+  const double invCount{1.0 / static_cast<double>(candidateCount)};
+  const uint32_t guessDigits{utils::packedDigits[guessRank]};
   double score{0.0};
   for (size_t pos{0}; pos < utils::numberSize; ++pos) {
-    score += digitFreq.at(pos).at(guessDigits.at(pos)) * invCount;
+    score += counts[pos][utils::packedDigitAt(guessDigits, pos)] * invCount;
   }
 
   return score;
-}
\ No newline at end of file
+}
@@ -6,9 +6,10 @@
 #pragma once
 
 #include "../interface/i_guess_strategy.hpp"
+#include "candidate_view.hpp"
+#include <array>
 #include <cstdint>
 #include <string_view>
-#include <vector>
 
 /**
  * @class FrequencyStrategy
@@ -24,6 +25,9 @@
  */
 class FrequencyStrategy final : public IGuessStrategy {
 public:
+  using DigitCounts = std::array<std::array<int32_t, utils::alphabetSize>,
+                                 utils::numberSize>; ///< Count by pos, digit
+
   /**
    * @brief Default constructor
    */
@@ -31,13 +35,13 @@ public:
 
   /**
    * @brief Select the best guess using frequency analysis
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @param history Reference to the guess history manager
    * @return The guess that best covers frequent digit patterns
    */
   [[nodiscard]] int32_t
-  selectBestGuess(const std::vector<int32_t>& possibleNumbers,
-                  const GuessHistoryManager& history) const noexcept override;
+  selectBestGuess(const CandidateView& candidates,
+                  const GuessHistoryManager& history) const override;
 
   /**
    * @brief Get the name of this strategy
@@ -48,10 +52,28 @@ public:
   /**
    * @brief Calculate frequency score for a potential guess
    * @param guess The potential guess to evaluate
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @return Frequency score (higher values indicate better coverage of frequent digits)
    */
   [[nodiscard]] double
-  calculateFrequency(int32_t guess,
-                     const std::vector<int32_t>& possibleNumbers) const noexcept;
+  calculateFrequency(int32_t guess, const CandidateView& candidates) const;
+
+  /**
+   * @brief Count how often each digit appears at each position
+   * @param candidates View of the numbers still considered possible
+   * @return Digit counts; they do not depend on the guess, so callers scoring
+   * many guesses against the same candidates compute them once
+   */
+  [[nodiscard]] DigitCounts
+  countDigits(const CandidateView& candidates) const;
+
+  /**
+   * @brief Calculate frequency score from precomputed digit counts
+   * @param guessRank Rank of the potential guess
+   * @param counts Digit counts from countDigits
+   * @param candidateCount Number of candidates the counts were built from
+   * @return Frequency score, identical to calculateFrequency
+   */
+  [[nodiscard]] double scoreDigits(size_t guessRank, const DigitCounts& counts,
+                                   size_t candidateCount) const;
 };
@@ -0,0 +1,339 @@
+/**
+ * @file game_tree_search.cpp
+ * @brief Implementation of GameTreeSearch class
+ */
+
+#include "game_tree_search.hpp"
+#include "../utils/number_universe.hpp"
+#include "../utils/parallel.hpp"
+#include "feedback_table.hpp"
+#include "guess_history_manager.hpp"
+#include "symmetry_reducer.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t winCode{
+    utils::encodeFeedback(utils::numberSize, 0)}; ///< Code of a correct guess
+
+using CodeCounts =
+    std::array<uint32_t, utils::feedbackCodeCount>; ///< Part size by code
+
+/**
+ * @brief Compute the lower bound of GameTreeSearch::lowerBound
+ * @param size Number of candidates
+ * @return Total guesses with the widest possible split at every guess
+ */
+constexpr uint64_t computeLowerBound(size_t size) {
+  // At most one candidate is found by the current guess, and every further
+  // guess can multiply the number of distinguishable lines by the number of
+  // non-winning feedbacks
+  constexpr uint64_t branching{utils::feedbackBucketCount - 1};
+  uint64_t total{0};
+  uint64_t capacity{1};
+  for (uint64_t depth{1}; size > 0; ++depth) {
+    const uint64_t found{std::min<uint64_t>(size, capacity)};
+    total += found * depth;
+    size -= static_cast<size_t>(found);
+    capacity *= branching;
+  }
+  return total;
+}
+
+/**
+ * @brief Tabulate the lower bound for every set size
+ * @return Lower bound by size
+ */
+std::vector<uint64_t> generateLowerBounds() {
+  std::vector<uint64_t> bounds(utils::validNumberCount + 1);
+  for (size_t size{0}; size < bounds.size(); ++size) {
+    bounds[size] = computeLowerBound(size);
+  }
+  return bounds;
+}
+
+// Filled at startup: one entry per possible set size is more than the
+// compiler will evaluate for six digits
+const std::vector<uint64_t> lowerBounds{
+    generateLowerBounds()}; ///< Lower bound by set size
+
+/**
+ * @brief Count the candidates that give every feedback code against a guess
+ * @param codes Feedback codes of the guess against every rank
+ * @param set Ascending ranks of the candidates
+ * @return Part size per feedback code
+ */
+CodeCounts
+countCodes(const std::span<const uint8_t, utils::validNumberCount> codes,
+           const std::span<const utils::Rank> set) {
+  CodeCounts counts{};
+  for (const utils::Rank target : set) {
+    ++counts[codes[target]];
+  }
+  return counts;
+}
+
+} // namespace
+
+GameTreeSearch& GameTreeSearch::getInstance() {
+  static GameTreeSearch instance{};
+  return instance;
+}
+
+GameTreeSearch::GameTreeSearch() = default;
+
+std::optional<GameTreeSearch::Decision>
+GameTreeSearch::solve(const CandidateView& candidates,
+                      const GuessHistoryManager& history,
+                      const size_t workerCount,
+                      const std::stop_token& stop) const {
+  if constexpr (!FeedbackTable::tabulated) {
+    throw std::runtime_error("Exhaustive search needs a feedback table, "
+                             "which this variant is too large for");
+  }
+
+  if (candidates.empty()) {
+    return std::nullopt;
+  }
+
+  std::vector<utils::Rank> set;
+  set.reserve(candidates.size());
+  candidates.forEach([&set](const size_t rank) {
+    set.push_back(static_cast<utils::Rank>(rank));
+  });
+
+  // Guessing the smaller of two candidates is as good as it gets
+  if (set.size() <= 2) {
+    return Decision{utils::unrank(set.front()), lowerBound(set.size())};
+  }
+
+  const SymmetryReducer symmetry{history};
+  const auto guesses{
+      orderGuesses(set, symmetry.getGuessRanks(),
+                   std::numeric_limits<uint64_t>::max())
+          .guesses};
+  const uint32_t usedDigits{symmetry.getUsedDigits()};
+
+  // Workers prune against their own best and, to share progress, against
+  // the best cost found by any worker; ties with the latter are still
+  // searched so that every worker reports its first optimal guess
+  std::atomic<uint64_t> sharedBest{std::numeric_limits<uint64_t>::max()};
+  std::vector<uint64_t> workerBest(std::max<size_t>(workerCount, 1),
+                                   std::numeric_limits<uint64_t>::max());
+
+  std::optional<utils::ArgBest<uint64_t>> best;
+  try {
+    best = utils::parallelArgBest(
+        guesses.size(), workerCount,
+        [&](const size_t worker,
+            const size_t index) -> std::optional<uint64_t> {
+          if (stop.stop_requested()) {
+            throw Stopped{};
+          }
+          const uint64_t shared{sharedBest.load(std::memory_order_relaxed)};
+          const uint64_t cutoff{std::min(
+              workerBest[worker],
+              shared == std::numeric_limits<uint64_t>::max() ? shared
+                                                             : shared + 1)};
+          const auto [guessBound, rank]{guesses[index]};
+          if (guessBound >= cutoff) {
+            return std::nullopt;
+          }
+
+          const uint64_t cost{searchGuess(set, rank, usedDigits, cutoff, stop)};
+          if (cost >= cutoff) {
+            return std::nullopt;
+          }
+
+          workerBest[worker] = cost;
+          uint64_t current{shared};
+          while (cost < current && !sharedBest.compare_exchange_weak(
+                                       current, cost,
+                                       std::memory_order_relaxed)) {
+          }
+          return cost;
+        },
+        std::less{});
+  } catch (const Stopped&) {
+    return std::nullopt;
+  }
+
+  if (!best.has_value()) {
+    return Decision{candidates.front(), lowerBound(set.size())};
+  }
+
+  m_memo.store(SetMemo::canonicalize(set), {best->score, true});
+  return Decision{utils::unrank(guesses[best->index].second), best->score};
+}
+
+size_t GameTreeSearch::getMemoSize() const { return m_memo.size(); }
+
+void GameTreeSearch::clear() { m_memo.clear(); }
+
+uint64_t GameTreeSearch::lowerBound(const size_t size) {
+  return lowerBounds[size];
+}
+
+uint64_t GameTreeSearch::search(const std::span<const utils::Rank> set,
+                                const uint32_t usedDigits,
+                                const uint64_t cutoff,
+                                const std::stop_token& stop) const {
+  // One or two candidates are solved by guessing them in turn
+  if (set.size() <= 2) {
+    return lowerBound(set.size());
+  }
+
+  uint64_t bound{lowerBound(set.size())};
+  if (bound >= cutoff) {
+    return bound;
+  }
+
+  std::vector<utils::Rank> key{SetMemo::canonicalize(set)};
+  if (const auto known{m_memo.lookup(key)}; known.has_value()) {
+    if (known->exact || known->cost >= cutoff) {
+      return known->cost;
+    }
+    bound = std::max(bound, known->cost);
+  }
+
+  // A candidate that tells all others apart reaches the size bound at once
+  if (bound == 2 * set.size() - 1 && hasPerfectSplit(set)) {
+    m_memo.store(std::move(key), {bound, true});
+    return bound;
+  }
+
+  // No guess beats the best bound of a single guess
+  const SymmetryReducer symmetry{usedDigits};
+  const auto [guessesBound, guesses]{
+      orderGuesses(set, symmetry.getGuessRanks(), cutoff)};
+  bound = std::max(bound, guessesBound);
+  if (bound >= cutoff) {
+    m_memo.store(std::move(key), {bound, false});
+    return bound;
+  }
+
+  uint64_t best{cutoff};
+  for (const auto& [guessBound, rank] : guesses) {
+    if (guessBound >= best) {
+      break; // Guesses are sorted by bound, so no later guess can do better
+    }
+    if (stop.stop_requested()) {
+      throw Stopped{};
+    }
+    best = std::min(best, searchGuess(set, rank, usedDigits, best, stop));
+    if (best == bound) {
+      break;
+    }
+  }
+
+  if (best < cutoff) {
+    m_memo.store(std::move(key), {best, true});
+    return best;
+  }
+  m_memo.store(std::move(key), {cutoff, false});
+  return cutoff;
+}
+
+uint64_t GameTreeSearch::searchGuess(const std::span<const utils::Rank> set,
+                                     const size_t guessRank,
+                                     const uint32_t usedDigits,
+                                     const uint64_t cutoff,
+                                     const std::stop_token& stop) const {
+  const auto codes{FeedbackTable::getInstance().row(guessRank)};
+  const CodeCounts counts{countCodes(codes, set)};
+
+  // Split the candidates into contiguous, still ascending parts
+  std::array<uint32_t, utils::feedbackCodeCount + 1> offsets{};
+  for (size_t code{0}; code < utils::feedbackCodeCount; ++code) {
+    offsets[code + 1] = offsets[code] + counts[code];
+  }
+  std::vector<utils::Rank> parts(set.size());
+  std::array<uint32_t, utils::feedbackCodeCount> next{};
+  std::copy_n(offsets.begin(), utils::feedbackCodeCount, next.begin());
+  for (const utils::Rank target : set) {
+    parts[next[codes[target]]++] = target;
+  }
+
+  // Search large parts first; they decide whether the guess is abandoned
+  std::array<uint8_t, utils::feedbackBucketCount> order{};
+  size_t orderCount{0};
+  uint64_t total{set.size()};
+  for (size_t code{0}; code < utils::feedbackCodeCount; ++code) {
+    if (code != winCode && counts[code] > 0) {
+      order[orderCount++] = static_cast<uint8_t>(code);
+      total += lowerBounds[counts[code]];
+    }
+  }
+  std::sort(order.begin(), order.begin() + orderCount,
+            [&counts](const uint8_t lhs, const uint8_t rhs) {
+              return counts[lhs] > counts[rhs];
+            });
+
+  const uint32_t nextUsedDigits{usedDigits | utils::digitMasks[guessRank]};
+  for (size_t i{0}; i < orderCount && total < cutoff; ++i) {
+    const uint8_t code{order[i]};
+    const uint64_t bound{lowerBounds[counts[code]]};
+    const std::span<const utils::Rank> part{parts.data() + offsets[code],
+                                            counts[code]};
+    total +=
+        search(part, nextUsedDigits, cutoff - (total - bound), stop) - bound;
+  }
+  return total;
+}
+
+bool GameTreeSearch::hasPerfectSplit(const std::span<const utils::Rank> set) {
+  const FeedbackTable& table{FeedbackTable::getInstance()};
+  return std::ranges::any_of(set, [&](const utils::Rank guessRank) {
+    return std::ranges::all_of(
+        countCodes(table.row(guessRank), set),
+        [](const uint32_t count) { return count <= 1; });
+  });
+}
+
+GameTreeSearch::GuessOrder
+GameTreeSearch::orderGuesses(const std::span<const utils::Rank> set,
+                             const std::span<const utils::Rank> guessRanks,
+                             const uint64_t cutoff) {
+  const FeedbackTable& table{FeedbackTable::getInstance()};
+
+  // Feedback is symmetric in guess and target, so the codes of ascending
+  // guesses are read as a few sequential streams, one per candidate row,
+  // instead of scattered loads from a different row per guess
+  std::vector<const uint8_t*> rows;
+  rows.reserve(set.size());
+  for (const utils::Rank target : set) {
+    rows.push_back(table.row(target).data());
+  }
+
+  GuessOrder order{std::numeric_limits<uint64_t>::max(), {}};
+  for (const utils::Rank rank : guessRanks) {
+    CodeCounts counts{};
+    for (const uint8_t* const row : rows) {
+      ++counts[row[rank]];
+    }
+
+    // A guess that leaves every candidate in one part only wastes a turn
+    if (counts[winCode] == 0 &&
+        std::ranges::find(counts, set.size()) != counts.end()) {
+      continue;
+    }
+
+    uint64_t bound{set.size()};
+    for (size_t code{0}; code < utils::feedbackCodeCount; ++code) {
+      bound += code == winCode ? 0 : lowerBounds[counts[code]];
+    }
+    order.bound = std::min(order.bound, bound);
+    if (bound < cutoff) {
+      order.guesses.emplace_back(bound, rank);
+    }
+  }
+
+  std::ranges::sort(order.guesses);
+  return order;
+}
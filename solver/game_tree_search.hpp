@@ -0,0 +1,170 @@
+/**
+ * @file game_tree_search.hpp
+ * @brief Exact game-tree search for the policy with the fewest total guesses
+ */
+
+#pragma once
+
+#include "candidate_view.hpp"
+#include "set_memo.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+class GuessHistoryManager;
+
+/**
+ * @class GameTreeSearch
+ * @brief Branch-and-bound search over feedback partitions
+ *
+ * The cost of a set of candidates is the total number of guesses an optimal
+ * policy needs to find every one of them, counting the final correct guess;
+ * dividing by the set size gives the expected number of guesses. A guess
+ * costs one guess per candidate plus the cost of every part it splits the
+ * candidates into, except the part of the guess itself.
+ *
+ * Guesses are tried in order of a lower bound that assumes every part is
+ * solved as fast as the branching factor allows, and a guess is abandoned as
+ * soon as its bound or its partly searched cost reaches the best cost found.
+ * Exact costs and the lower bounds of abandoned searches are memoized by
+ * canonical candidate set (see SetMemo). The cost of a set does not depend on
+ * how it was reached, so one memo is shared by every solver in the process
+ * and is safe to use from several threads.
+ *
+ * Every guess is considered, not only candidates, but one guess per class of
+ * digit relabelings that fix the position is tried (see SymmetryReducer), so
+ * the candidates must be exactly the numbers consistent with the history.
+ */
+class GameTreeSearch {
+public:
+  /**
+   * @struct Decision
+   * @brief Optimal guess at a position and the cost it leads to
+   */
+  struct Decision {
+    int32_t guess;         ///< Guess to make
+    uint64_t totalGuesses; ///< Guesses needed to find every candidate
+  };
+
+  /**
+   * @brief Get the process-wide search and its memo
+   * @return Reference to the shared search
+   */
+  [[nodiscard]] static GameTreeSearch& getInstance();
+
+  GameTreeSearch(const GameTreeSearch&) = delete;
+  GameTreeSearch& operator=(const GameTreeSearch&) = delete;
+
+  /**
+   * @brief Find the guess that minimizes the total guesses at a position
+   * @param candidates Numbers consistent with history
+   * @param history The guesses made so far
+   * @param workerCount Threads sharing the guesses of the position
+   * @param stop Abandons the search between two guesses once requested
+   * @return The lowest-ranked optimal guess in bound order and its cost, or
+   * nullopt if there are no candidates or the search was stopped
+   *
+   * @throws std::runtime_error if the variant has no feedback table
+   *
+   * The decision does not depend on workerCount. A stopped search memoizes
+   * only the sets it finished.
+   */
+  [[nodiscard]] std::optional<Decision>
+  solve(const CandidateView& candidates, const GuessHistoryManager& history,
+        size_t workerCount, const std::stop_token& stop = {}) const;
+
+  /**
+   * @brief Get the number of memoized sets
+   * @return Entries in the memo
+   */
+  [[nodiscard]] size_t getMemoSize() const;
+
+  /**
+   * @brief Forget every memoized set
+   */
+  void clear();
+
+  /**
+   * @brief Lower bound on the cost of any set of a given size
+   * @param size Number of candidates
+   * @return Total guesses if each guess could split the candidates into
+   * utils::feedbackBucketCount - 1 parts plus the guess itself
+   */
+  [[nodiscard]] static uint64_t lowerBound(size_t size);
+
+private:
+  /**
+   * @struct Stopped
+   * @brief Unwinds a search whose stop was requested, past every memo store
+   */
+  struct Stopped {};
+
+  /**
+   * @brief Private constructor that creates an empty memo
+   */
+  GameTreeSearch();
+
+  /**
+   * @brief Compute the cost of a set, giving up once it reaches a cutoff
+   * @param set Ascending ranks of the candidates
+   * @param usedDigits Bit d set when digit d appears in a guess so far
+   * @param cutoff Costs at or above this value are not needed exactly
+   * @param stop Abandons the search once requested
+   * @return The exact cost if below cutoff, otherwise a lower bound that is
+   * at least cutoff
+   * @throws Stopped once a stop is requested
+   */
+  [[nodiscard]] uint64_t search(std::span<const utils::Rank> set,
+                                uint32_t usedDigits, uint64_t cutoff,
+                                const std::stop_token& stop) const;
+
+  /**
+   * @brief Compute the cost of a guess, giving up once it reaches a cutoff
+   * @param set Ascending ranks of the candidates
+   * @param guessRank Rank of the guess
+   * @param usedDigits Bit d set when digit d appears in a guess so far
+   * @param cutoff Costs at or above this value are not needed exactly
+   * @param stop Abandons the search once requested
+   * @return The exact cost if below cutoff, otherwise a lower bound that is
+   * at least cutoff
+   * @throws Stopped once a stop is requested
+   */
+  [[nodiscard]] uint64_t searchGuess(std::span<const utils::Rank> set,
+                                     size_t guessRank, uint32_t usedDigits,
+                                     uint64_t cutoff,
+                                     const std::stop_token& stop) const;
+
+  /**
+   * @brief Check whether a candidate splits the others into single numbers
+   * @param set Ascending ranks of the candidates
+   * @return true if guessing some candidate identifies every other one
+   */
+  [[nodiscard]] static bool hasPerfectSplit(std::span<const utils::Rank> set);
+
+  /**
+   * @struct GuessOrder
+   * @brief Guesses worth searching at a position, most promising first
+   */
+  struct GuessOrder {
+    uint64_t bound; ///< Lower bound on the cost of the position
+    std::vector<std::pair<uint64_t, utils::Rank>>
+        guesses; ///< (bound, rank) of guesses below the cutoff, ascending
+  };
+
+  /**
+   * @brief Bound the cost of every useful guess and sort them by bound
+   * @param set Ascending ranks of the candidates
+   * @param guessRanks Guesses to consider
+   * @param cutoff Guesses bounded at or above this value are dropped
+   * @return The best bound over all guesses and the guesses below cutoff
+   */
+  [[nodiscard]] static GuessOrder
+  orderGuesses(std::span<const utils::Rank> set,
+               std::span<const utils::Rank> guessRanks, uint64_t cutoff);
+
+  SetMemo m_memo; ///< Costs by canonical set
+};
@@ -5,6 +5,7 @@
 
 #include "guess_history_manager.hpp"
 #include "../utils/utils.hpp"
+#include "feedback_table.hpp"
 #include <algorithm>
 #include <ranges>
 
@@ -19,17 +20,19 @@ bool GuessHistoryManager::hasBeenGuessed(const int32_t number) const {
 }
 
 bool GuessHistoryManager::isConsistentWithHistory(const int32_t number) const {
+  const FeedbackTable& table{FeedbackTable::getInstance()};
+
   // Check consistency with all previous guesses and their feedback
   return std::ranges::all_of(
       // Pair each guess with its feedback
       std::views::zip(m_guessHistory, m_feedbackHistory),
       // Check if the feedback matches the expected A and B counts for the
       // number
-      [number](const auto& pair) {
+      [number, &table](const auto& pair) {
         const auto& [guess, feedback]{pair};
         const auto [expectedA, expectedB]{feedback};
-        const auto [actualA, actualB]{utils::calculateAB(guess, number)};
-        return expectedA == actualA && expectedB == actualB;
+        return table.lookup(guess, number) ==
+               utils::encodeFeedback(expectedA, expectedB);
       });
 }
 
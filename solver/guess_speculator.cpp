@@ -0,0 +1,168 @@
+/**
+ * @file guess_speculator.cpp
+ * @brief Implementation of GuessSpeculator class
+ */
+
+#include "guess_speculator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct Branch
+ * @brief Position reached by one feedback to the speculated guess
+ */
+struct Branch {
+  size_t bucket;                  ///< Feedback bucket
+  GuessHistoryManager history;    ///< History including the feedback
+  SearchSpaceManager searchSpace; ///< Numbers consistent with history
+};
+
+} // namespace
+
+void GuessSpeculator::start(StrategySelector selector,
+                            const SearchSpaceManager& searchSpace,
+                            const GuessHistoryManager& history,
+                            const int32_t guess) {
+  if (m_run && m_thread.joinable() &&
+      !m_thread.get_stop_token().stop_requested()) {
+    const std::scoped_lock lock{m_run->mutex};
+    if (m_run->baseGuessCount == history.getGuessCount() &&
+        m_run->guess == guess) {
+      return; // Already speculating on this guess
+    }
+  }
+
+  // The previous thread keeps writing to its own run until it notices the
+  // stop, so the new run starts without waiting for it
+  cancel();
+  m_run = std::make_shared<Run>();
+  m_run->baseGuessCount = history.getGuessCount();
+  m_run->guess = guess;
+
+  m_thread = std::jthread{[run = m_run, selector = std::move(selector),
+                           searchSpace, history,
+                           guess](const std::stop_token stop) mutable {
+    std::vector<Branch> branches;
+    for (int32_t aCount{0}; aCount < utils::numberSize; ++aCount) {
+      for (int32_t bCount{0}; aCount + bCount <= utils::numberSize;
+           ++bCount) {
+        const int8_t bucket{
+            utils::feedbackBuckets[utils::encodeFeedback(aCount, bCount)]};
+        if (bucket < 0) {
+          continue;
+        }
+
+        // A single candidate is answered without a selection
+        SearchSpaceManager nextSpace{searchSpace};
+        nextSpace.applyConstraint(guess, aCount, bCount);
+        if (nextSpace.getRemainingCount() <= 1) {
+          continue;
+        }
+
+        GuessHistoryManager nextHistory{history};
+        nextHistory.addGuess(guess, aCount, bCount);
+        branches.push_back({static_cast<size_t>(bucket),
+                            std::move(nextHistory), std::move(nextSpace)});
+      }
+    }
+    std::ranges::stable_sort(branches, [](const Branch& lhs,
+                                          const Branch& rhs) {
+      return lhs.searchSpace.getRemainingCount() >
+             rhs.searchSpace.getRemainingCount();
+    });
+
+    for (const Branch& branch : branches) {
+      {
+        const std::scoped_lock lock{run->mutex};
+        if (stop.stop_requested()) {
+          break;
+        }
+        run->runningBucket = branch.bucket;
+      }
+
+      // Cached scores are only valid for the search space they were built
+      // for. A stop abandons the scan, and its inexact guess is dropped.
+      selector.clearCaches();
+      const IGuessStrategy::Selection selection{selector.selectGuessBefore(
+          branch.searchSpace.getCandidates(), branch.history,
+          utils::Deadline{std::chrono::steady_clock::time_point::max(),
+                          stop})};
+
+      {
+        const std::scoped_lock lock{run->mutex};
+        if (selection.exact) {
+          run->guesses[branch.bucket] = selection.guess;
+        }
+        run->runningBucket.reset();
+      }
+      run->ready.notify_all();
+    }
+
+    {
+      const std::scoped_lock lock{run->mutex};
+      run->runningBucket.reset();
+      run->finished = true;
+    }
+    run->ready.notify_all();
+  }};
+}
+
+std::optional<int32_t>
+GuessSpeculator::take(const GuessHistoryManager& history) {
+  if (!m_run || !m_thread.joinable() ||
+      m_thread.get_stop_token().stop_requested()) {
+    return std::nullopt;
+  }
+
+  // Until the feedback arrives the speculation still applies
+  const auto& guesses{history.getGuesses()};
+  if (guesses.size() == m_run->baseGuessCount) {
+    return std::nullopt;
+  }
+  if (guesses.size() != m_run->baseGuessCount + 1 ||
+      guesses.back() != m_run->guess) {
+    cancel();
+    return std::nullopt;
+  }
+
+  const auto [aCount, bCount]{history.getFeedback().back()};
+  const int8_t bucket{
+      aCount < 0 || bCount < 0 || aCount + bCount > utils::numberSize
+          ? int8_t{-1}
+          : utils::feedbackBuckets[utils::encodeFeedback(aCount, bCount)]};
+  if (bucket < 0) {
+    cancel();
+    return std::nullopt;
+  }
+
+  // Waiting only on the position that was asked for, which the caller would
+  // otherwise have to compute itself
+  std::optional<int32_t> guess;
+  {
+    std::unique_lock lock{m_run->mutex};
+    m_run->ready.wait(lock, [&] {
+      return m_run->runningBucket != static_cast<size_t>(bucket);
+    });
+    guess = m_run->guesses[static_cast<size_t>(bucket)];
+  }
+  cancel();
+  return guess;
+}
+
+void GuessSpeculator::cancel() {
+  if (m_thread.joinable()) {
+    m_thread.request_stop();
+    m_retired.emplace_back(std::move(m_run), std::move(m_thread));
+  }
+  m_run.reset();
+
+  // Joining a thread that has finished is instant
+  std::erase_if(m_retired, [](const auto& retired) {
+    const std::scoped_lock lock{retired.first->mutex};
+    return retired.first->finished;
+  });
+}
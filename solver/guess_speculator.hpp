@@ -0,0 +1,105 @@
+/**
+ * @file guess_speculator.hpp
+ * @brief Background computation of the guesses that may follow a guess
+ */
+
+#pragma once
+
+#include "../utils/utils.hpp"
+#include "guess_history_manager.hpp"
+#include "search_space_manager.hpp"
+#include "strategy_selector.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class GuessSpeculator
+ * @brief Precomputes the next guess for every feedback a guess can receive
+ *
+ * While the feedback for a guess is awaited, a background thread selects the
+ * guess that would follow each feedback, starting with the feedback that
+ * leaves the most candidates since it is both the likeliest and the slowest
+ * to compute. Once the real feedback is known, take() hands out its guess,
+ * waiting for it if it is being computed, and stops the thread.
+ *
+ * Stopping does not wait for the thread. The stop request reaches the
+ * selection itself: the heuristic strategies abandon their scan within one
+ * block of guesses per worker, and the exact searches between two guesses,
+ * keeping in their memos only the sets they finished. A stopped thread
+ * writes only to its own results and is joined once it has finished, by a
+ * later start() or by the destructor, which therefore waits no longer than
+ * the guesses being scored when the stop came.
+ *
+ * The thread selects with its own StrategySelector, configured like the
+ * solver's, so speculated guesses are identical to computed ones.
+ */
+class GuessSpeculator {
+public:
+  GuessSpeculator() = default;
+
+  GuessSpeculator(const GuessSpeculator&) = delete;
+  GuessSpeculator& operator=(const GuessSpeculator&) = delete;
+
+  /**
+   * @brief Start computing the guesses that may follow a guess
+   * @param selector Selector to compute them with, owned by the thread
+   * @param searchSpace Numbers consistent with history
+   * @param history The guesses made before guess
+   * @param guess The guess awaiting feedback
+   *
+   * Earlier speculation is stopped, unless it already covers the same guess
+   * after the same number of guesses.
+   */
+  void start(StrategySelector selector, const SearchSpaceManager& searchSpace,
+             const GuessHistoryManager& history, int32_t guess);
+
+  /**
+   * @brief Take the speculated guess for the position a history reached
+   * @param history The guesses so far, ending with the speculated guess and
+   * its feedback
+   * @return The guess computed for that feedback, or nullopt if it was not
+   * computed or the history is not the speculated one
+   *
+   * Any further speculation is stopped, except while history still ends
+   * before the speculated guess.
+   */
+  [[nodiscard]] std::optional<int32_t>
+  take(const GuessHistoryManager& history);
+
+  /**
+   * @brief Stop speculating without waiting for the thread
+   *
+   * Guesses computed so far are discarded as well. Stopped threads that
+   * have finished since are joined.
+   */
+  void cancel();
+
+private:
+  /**
+   * @struct Run
+   * @brief Results of one speculation, shared with its thread
+   */
+  struct Run {
+    std::mutex mutex;                    ///< Guards the fields below
+    std::condition_variable ready;       ///< Signals a finished position
+    size_t baseGuessCount{0};            ///< Guesses before the speculated one
+    int32_t guess{0};                    ///< The speculated guess
+    std::optional<size_t> runningBucket; ///< Feedback being computed, if any
+    std::array<std::optional<int32_t>, utils::feedbackBucketCount>
+        guesses;          ///< Computed guess per feedback bucket
+    bool finished{false}; ///< Whether the thread has stopped
+  };
+
+  std::shared_ptr<Run> m_run; ///< Results of the current speculation
+  std::vector<std::pair<std::shared_ptr<Run>, std::jthread>>
+      m_retired;         ///< Stopped threads not yet joined, with their runs
+  std::jthread m_thread; ///< Speculation thread; declared last to stop first
+};
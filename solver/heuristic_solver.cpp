@@ -1,4 +1,5 @@
 #include "heuristic_solver.hpp"
+#include <utility>
 
 HeuristicSolver::HeuristicSolver(const GuessStrategy strategy)
     : m_strategySelector{convertStrategy(strategy)} {}
@@ -13,9 +14,49 @@ std::optional<int32_t> HeuristicSolver::nextGuess() {
     return m_searchSpace.getSingleRemaining();
   }
 
-  // Get possible numbers and use strategy selector to choose best guess
-  const auto possibleNumbers{m_searchSpace.getPossibleNumbers()};
-  return m_strategySelector.selectGuess(possibleNumbers, m_history);
+  // A guess prepared while the feedback was awaited needs no computation
+  if (m_speculator) {
+    if (const auto guess{m_speculator->take(m_history)}; guess.has_value()) {
+      speculate(guess.value());
+      return guess;
+    }
+  }
+
+  // Hand a view of the possible numbers to the strategy selector
+  const int32_t guess{m_strategySelector.selectGuess(
+      m_searchSpace.getCandidates(), m_history)};
+  speculate(guess);
+  return guess;
+}
+
+std::optional<HeuristicSolver::TimedGuess>
+HeuristicSolver::nextGuess(const std::chrono::nanoseconds budget) {
+  const utils::Deadline deadline{std::chrono::steady_clock::now() + budget,
+                                 {}};
+
+  if (m_searchSpace.isEmpty()) {
+    return std::nullopt; // No valid guesses left
+  }
+
+  // If only one possibility remains, return it
+  if (const auto single{m_searchSpace.getSingleRemaining()};
+      single.has_value()) {
+    return TimedGuess{single.value(), true};
+  }
+
+  // A guess prepared while the feedback was awaited needs no computation
+  if (m_speculator) {
+    if (const auto guess{m_speculator->take(m_history)}; guess.has_value()) {
+      speculate(guess.value());
+      return TimedGuess{guess.value(), true};
+    }
+  }
+
+  const IGuessStrategy::Selection selection{
+      m_strategySelector.selectGuessBefore(m_searchSpace.getCandidates(),
+                                           m_history, deadline)};
+  speculate(selection.guess);
+  return TimedGuess{selection.guess, selection.exact};
 }
 
 void HeuristicSolver::updateGuess(const int32_t guess, const int32_t aCount,
@@ -30,6 +71,17 @@ void HeuristicSolver::updateGuess(const int32_t guess, const int32_t aCount,
   m_searchSpace.applyConstraint(guess, aCount, bCount);
 }
 
+void HeuristicSolver::restoreHistory(const GuessHistoryManager& history) {
+  if (m_speculator) {
+    m_speculator->cancel();
+  }
+  m_history = history;
+  m_strategySelector.clearCaches();
+
+  m_searchSpace.reset();
+  m_searchSpace.applyHistory(history);
+}
+
 bool HeuristicSolver::isSolved() const { return m_searchSpace.hasOnlyOne(); }
 
 size_t HeuristicSolver::getRemainingCount() const {
@@ -37,6 +89,9 @@ size_t HeuristicSolver::getRemainingCount() const {
 }
 
 void HeuristicSolver::setStrategy(const GuessStrategy strategy) {
+  if (m_speculator) {
+    m_speculator->cancel();
+  }
   m_strategySelector.setStrategy(convertStrategy(strategy));
 }
 
@@ -52,6 +107,54 @@ std::string_view HeuristicSolver::getStrategyName(const GuessStrategy strategy)
   return StrategySelector::getStrategyName(convertStrategy(strategy));
 }
 
+void HeuristicSolver::setWorkerCount(const size_t workerCount) {
+  m_strategySelector.setWorkerCount(workerCount);
+}
+
+size_t HeuristicSolver::getWorkerCount() const {
+  return m_strategySelector.getWorkerCount();
+}
+
+void HeuristicSolver::addOpeningBook(std::shared_ptr<const OpeningBook> book) {
+  if (m_speculator) {
+    m_speculator->cancel();
+  }
+  m_strategySelector.addOpeningBook(std::move(book));
+}
+
+void HeuristicSolver::setEntropySampling(
+    const std::optional<EntropySampling>& sampling) {
+  if (m_speculator) {
+    m_speculator->cancel();
+  }
+  m_strategySelector.setEntropySampling(sampling);
+}
+
+void HeuristicSolver::setSpeculation(const bool enabled) {
+  if (!enabled) {
+    m_speculator.reset();
+  } else if (!m_speculator) {
+    m_speculator = std::make_unique<GuessSpeculator>();
+  }
+}
+
+void HeuristicSolver::speculate(const int32_t guess) {
+  if (!m_speculator) {
+    return;
+  }
+
+  // The thread needs a selector of its own; one configured like ours picks
+  // the same guesses
+  StrategySelector selector{m_strategySelector.getStrategy()};
+  selector.setWorkerCount(m_strategySelector.getWorkerCount());
+  selector.setEntropySampling(m_strategySelector.getEntropySampling());
+  selector.setTranspositions(m_strategySelector.usesTranspositions());
+  for (const auto& book : m_strategySelector.getOpeningBooks()) {
+    selector.addOpeningBook(book);
+  }
+  m_speculator->start(std::move(selector), m_searchSpace, m_history, guess);
+}
+
 StrategySelector::StrategyType
 HeuristicSolver::convertStrategy(const GuessStrategy strategy) {
   switch (strategy) {
@@ -61,6 +164,10 @@ HeuristicSolver::convertStrategy(const GuessStrategy strategy) {
     return StrategySelector::StrategyType::miniMax;
   case GuessStrategy::frequencyBased:
     return StrategySelector::StrategyType::frequencyBased;
+  case GuessStrategy::optimal:
+    return StrategySelector::StrategyType::optimal;
+  case GuessStrategy::worstCase:
+    return StrategySelector::StrategyType::worstCase;
   case GuessStrategy::hybrid:
   default:
     return StrategySelector::StrategyType::hybrid;
@@ -77,6 +184,10 @@ HeuristicSolver::convertStrategy(
     return GuessStrategy::miniMax;
   case StrategySelector::StrategyType::frequencyBased:
     return GuessStrategy::frequencyBased;
+  case StrategySelector::StrategyType::optimal:
+    return GuessStrategy::optimal;
+  case StrategySelector::StrategyType::worstCase:
+    return GuessStrategy::worstCase;
   case StrategySelector::StrategyType::hybrid:
   default:
     return GuessStrategy::hybrid;
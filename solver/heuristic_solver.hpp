@@ -2,8 +2,11 @@
 
 #include "../interface/interface.hpp"
 #include "guess_history_manager.hpp"
+#include "guess_speculator.hpp"
 #include "search_space_manager.hpp"
 #include "strategy_selector.hpp"
+#include <chrono>
+#include <memory>
 #include <optional>
 #include <string_view>
 
@@ -20,7 +23,18 @@ public:
     entropyBased,
     miniMax,
     frequencyBased,
-    hybrid
+    hybrid,
+    optimal,
+    worstCase
+  };
+
+  /**
+   * @struct TimedGuess
+   * @brief Guess selected within a time budget
+   */
+  struct TimedGuess {
+    int32_t guess; ///< Best guess found within the budget
+    bool exact;    ///< Whether it is the guess nextGuess() returns
   };
 
   /**
@@ -34,6 +48,28 @@ public:
   void updateGuess(int32_t guess, int32_t aCount, int32_t bCount) override;
   [[nodiscard]] bool isSolved() const override;
 
+  /**
+   * @brief Get the next guess, spending at most roughly a time budget
+   * @param budget Time allowed for scoring guesses
+   * @return The best guess found and whether the search completed, or
+   * nullopt if no candidates remain
+   *
+   * Guesses are scored most promising first: those that led the previous
+   * turn, then the candidates, then the remaining guesses, one per symmetry
+   * class. Scoring stops once the budget is spent, overrunning it by at most
+   * a few guesses per worker; at least a few guesses are always scored.
+   * Opening books, speculated guesses and the exact strategies are not
+   * bounded and always give an exact guess.
+   */
+  [[nodiscard]] std::optional<TimedGuess>
+  nextGuess(std::chrono::nanoseconds budget);
+
+  /**
+   * @brief Replace the solver state with a previously recorded history
+   * @param history The guesses and feedback of the session to resume
+   */
+  void restoreHistory(const GuessHistoryManager& history);
+
   /**
    * @brief Get the number of remaining possible numbers
    * @return Count of numbers considered possible
@@ -65,12 +101,6 @@ public:
    */
   [[nodiscard]] static std::string_view getStrategyName(GuessStrategy strategy);
 
-private:
-  SearchSpaceManager m_searchSpace; ///< Manages the set of possible numbers
-  GuessHistoryManager m_history;    ///< Tracks guess history and feedback
-  StrategySelector
-      m_strategySelector; ///< Coordinates strategy selection and execution
-
   /**
    * @brief Convert GuessStrategy enum to StrategySelector::StrategyType
    * @param strategy The GuessStrategy enum value
@@ -86,4 +116,64 @@ private:
    */
   [[nodiscard]] static GuessStrategy
   convertStrategy(StrategySelector::StrategyType strategy);
+
+  /**
+   * @brief Set the number of threads used to score potential guesses
+   * @param workerCount Number of workers, 0 for one per hardware thread
+   *
+   * Guesses are identical for every worker count; only latency changes.
+   */
+  void setWorkerCount(size_t workerCount);
+
+  /**
+   * @brief Get the number of threads used to score potential guesses
+   * @return Number of workers, at least 1
+   */
+  [[nodiscard]] size_t getWorkerCount() const;
+
+  /**
+   * @brief Register an opening book consulted before computing a guess
+   * @param book The book; it applies while its strategy is selected
+   */
+  void addOpeningBook(std::shared_ptr<const OpeningBook> book);
+
+  /**
+   * @brief Enable or disable approximate entropy in large search spaces
+   * @param sampling Race settings, or nullopt to score every guess exactly
+   *
+   * Trades slightly different guesses in the early turns of the entropy and
+   * hybrid strategies for much less work; see EntropyStrategy::setSampling.
+   */
+  void setEntropySampling(const std::optional<EntropySampling>& sampling);
+
+  /**
+   * @brief Enable or disable computing follow-up guesses in the background
+   * @param enabled Whether nextGuess starts speculation on its result
+   *
+   * When enabled, every guess returned by nextGuess is followed by a
+   * background thread that prepares the next guess for each feedback, so
+   * that the nextGuess after updateGuess returns at once. Guesses are the
+   * same either way. Disabled by default.
+   */
+  void setSpeculation(bool enabled);
+
+  /**
+   * @brief Check whether follow-up guesses are computed in the background
+   * @return true if speculation is enabled
+   */
+  [[nodiscard]] bool isSpeculating() const { return m_speculator != nullptr; }
+
+private:
+  SearchSpaceManager m_searchSpace; ///< Manages the set of possible numbers
+  GuessHistoryManager m_history;    ///< Tracks guess history and feedback
+  StrategySelector
+      m_strategySelector; ///< Coordinates strategy selection and execution
+  std::unique_ptr<GuessSpeculator>
+      m_speculator; ///< Background follow-up guesses, null when disabled
+
+  /**
+   * @brief Start speculating on the guesses that may follow a guess
+   * @param guess The guess just returned by nextGuess
+   */
+  void speculate(int32_t guess);
 };
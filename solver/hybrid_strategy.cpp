@@ -4,7 +4,13 @@
  */
 
 #include "hybrid_strategy.hpp"
-#include "../utils/utils.hpp"
+#include "../utils/number_universe.hpp"
+#include "partition.hpp"
+#include "symmetry_reducer.hpp"
+#include "tiled_scorer.hpp"
+#include <functional>
+#include <optional>
+#include <span>
 
 HybridStrategy::HybridStrategy(const EntropyStrategy& entropyStrategy,
                                const MinimaxStrategy& minimaxStrategy,
@@ -13,65 +19,87 @@ HybridStrategy::HybridStrategy(const EntropyStrategy& entropyStrategy,
       m_frequencyStrategy{frequencyStrategy} {}
 
 int32_t
-HybridStrategy::selectBestGuess(const std::vector<int32_t>& possibleNumbers,
+HybridStrategy::selectBestGuess(const CandidateView& candidates,
                                 const GuessHistoryManager& history) const {
+  return selectGuessBefore(candidates, history, {}, utils::Deadline::max())
+      .guess;
+}
+
+IGuessStrategy::Selection HybridStrategy::selectGuessBefore(
+    const CandidateView& candidates, const GuessHistoryManager& history,
+    const std::span<const utils::Rank> preferred,
+    const utils::Deadline deadline) const {
 
-  if (possibleNumbers.empty()) {
-    return utils::minValidNumber; // Fallback to a known valid number
+  if (candidates.empty()) {
+    // Fallback to a known valid number
+    return {utils::minValidNumber, true, std::nullopt, {}};
   }
 
   // Early game: use entropy for maximum information gain
   if (history.getGuessCount() < 2) {
-    return m_entropyStrategy.selectBestGuess(possibleNumbers, history);
+    return m_entropyStrategy.selectGuessBefore(candidates, history, preferred,
+                                               deadline);
   }
 
   // Mid-game: balance entropy and minimax
-  if (possibleNumbers.size() > 10) {
-    int32_t bestGuess{possibleNumbers.at(0)};
-    double bestScore{-1.0};
-
-    for (size_t i{0}; i < utils::validNumberRange; ++i) {
-      const int32_t candidate{static_cast<int32_t>(i) + utils::minValidNumber};
-      if (!utils::isValidGuess(candidate).has_value()) {
-        continue;
-      }
-
-      // Skip if we've already guessed this number
-      if (history.hasBeenGuessed(candidate)) {
-        continue;
-      }
-
-      if (const double score{
-              calculateHybridScore(candidate, possibleNumbers, history)};
-          score > bestScore) {
-        bestScore = score;
-        bestGuess = candidate;
-      }
+  if (candidates.size() > 10) {
+    // Digit counts do not depend on the guess, so build them once per turn
+    const FrequencyStrategy::DigitCounts digitCounts{
+        m_frequencyStrategy.countDigits(candidates)};
+
+    // Equivalent unguessed guesses score the same; evaluate one per class,
+    // the most promising first
+    const SymmetryReducer symmetry{history};
+    const auto order{symmetry.getGuessOrder(candidates, preferred)};
+
+    const auto hybridScore{
+        [&](const size_t rank, const Partition& partition) {
+          return calculateHybridScore(rank, partition, digitCounts);
+        }};
+
+    // Variants without a feedback table partition a whole block of guesses
+    // per pass over the packed candidates
+    if (TiledScorer::isPreferred(candidates)) {
+      const TiledScorer scorer{candidates};
+      const auto scan{utils::parallelRankBlocksUntil<double>(
+          std::span<const utils::Rank>{order}, m_workerCount, leaderCount,
+          deadline,
+          [&](size_t, const std::span<const utils::Rank> block,
+              const std::span<std::optional<double>> scores) {
+            scorer.score(block, scores, hybridScore);
+          },
+          std::greater{})};
+      return toSelection(scan, candidates.front());
     }
 
-    return bestGuess;
+    const auto scan{utils::parallelRankUntil(
+        std::span<const utils::Rank>{order}, m_workerCount, leaderCount,
+        deadline,
+        [&](size_t, const size_t rank) -> std::optional<double> {
+          return hybridScore(rank, Partition{rank, candidates});
+        },
+        std::greater{})};
+
+    return toSelection(scan, candidates.front());
   }
 
   // End game: use minimax for guaranteed optimal worst-case
-  return m_minimaxStrategy.selectBestGuess(possibleNumbers, history);
+  return m_minimaxStrategy.selectGuessBefore(candidates, history, preferred,
+                                             deadline);
 }
 
 std::string_view HybridStrategy::getStrategyName() const { return "Hybrid"; }
 
 double HybridStrategy::calculateHybridScore(
-    int32_t guess, const std::vector<int32_t>& possibleNumbers,
-    [[maybe_unused]] const GuessHistoryManager& history) const {
-
-  // Calculate individual strategy scores using their respective methods
-  
-  // Entropy calculation using EntropyStrategy's calculateEntropy method
-  const double entropy = m_entropyStrategy.calculateEntropy(guess, possibleNumbers);
+    const size_t guessRank, const Partition& partition,
+    const FrequencyStrategy::DigitCounts& digitCounts) const {
 
-  // Minimax calculation using MinimaxStrategy's calculateMinimax method
-  const size_t minimaxValue = m_minimaxStrategy.calculateMinimax(guess, possibleNumbers);
+  // One pass over the candidates yields both entropy and worst case
+  const double entropy{partition.entropy()};
+  const size_t minimaxValue{partition.worstCase()};
 
-  // Frequency calculation using FrequencyStrategy's calculateFrequency method
-  const double frequency = m_frequencyStrategy.calculateFrequency(guess, possibleNumbers);
+  const double frequency{m_frequencyStrategy.scoreDigits(
+      guessRank, digitCounts, partition.total())};
 
   // Weighted combination of strategies (matching original implementation)
   const double score = 0.5 * entropy +
@@ -6,12 +6,14 @@
 #pragma once
 
 #include "../interface/i_guess_strategy.hpp"
+#include "candidate_view.hpp"
 #include "entropy_strategy.hpp"
 #include "frequency_strategy.hpp"
 #include "guess_history_manager.hpp"
 #include "minimax_strategy.hpp"
+#include "partition.hpp"
 #include <cstdint>
-#include <vector>
+#include <span>
 
 /**
  * @class HybridStrategy
@@ -36,15 +38,30 @@ public:
 
   /**
    * @brief Select the best guess using hybrid analysis
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @param history Reference to the guess history manager
    * @return The guess selected by the appropriate strategy for the current game
    * phase
    */
   [[nodiscard]] int32_t
-  selectBestGuess(const std::vector<int32_t>& possibleNumbers,
+  selectBestGuess(const CandidateView& candidates,
                   const GuessHistoryManager& history) const override;
 
+  /**
+   * @brief Select a guess for the current game phase before a deadline
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager
+   * @param preferred Ranks of guesses to score first
+   * @param deadline No further guesses are scored once it has passed
+   * @return The best guess scored before the deadline by the strategy of the
+   * current game phase
+   */
+  [[nodiscard]] Selection
+  selectGuessBefore(const CandidateView& candidates,
+                    const GuessHistoryManager& history,
+                    std::span<const utils::Rank> preferred,
+                    utils::Deadline deadline) const override;
+
   /**
    * @brief Get the name of this strategy
    * @return String identifier for this strategy
@@ -59,13 +76,15 @@ private:
 
   /**
    * @brief Calculate hybrid score combining multiple strategies
-   * @param guess The potential guess to evaluate
-   * @param possibleNumbers Vector of numbers still considered possible
-   * @param history Reference to the guess history manager
+   * @param guessRank Rank of the potential guess to evaluate
+   * @param partition Partition of the candidates by the guess
+   * @param digitCounts Digit counts of the candidates for this turn
    * @return Combined score using weighted strategy results
+   *
+   * Entropy and worst case come from a single Partition of the candidates
+   * rather than separate entropy and minimax passes.
    */
   [[nodiscard]] double
-  calculateHybridScore(int32_t guess,
-                       const std::vector<int32_t>& possibleNumbers,
-                       const GuessHistoryManager& history) const;
+  calculateHybridScore(size_t guessRank, const Partition& partition,
+                       const FrequencyStrategy::DigitCounts& digitCounts) const;
 };
@@ -4,81 +4,114 @@
  */
 
 #include "minimax_strategy.hpp"
-#include "../utils/utils.hpp"
-#include <algorithm>
-#include <map>
-#include <ranges>
+#include "../utils/number_universe.hpp"
+#include "partition.hpp"
+#include "symmetry_reducer.hpp"
+#include "tiled_scorer.hpp"
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 MinimaxStrategy::MinimaxStrategy(CacheManager<size_t>& cache)
     : m_cache{cache} {}
 
 int32_t
-MinimaxStrategy::selectBestGuess(const std::vector<int32_t>& possibleNumbers,
+MinimaxStrategy::selectBestGuess(const CandidateView& candidates,
                                  const GuessHistoryManager& history) const {
+  return selectGuessBefore(candidates, history, {}, utils::Deadline::max())
+      .guess;
+}
+
+IGuessStrategy::Selection MinimaxStrategy::selectGuessBefore(
+    const CandidateView& candidates, const GuessHistoryManager& history,
+    const std::span<const utils::Rank> preferred,
+    const utils::Deadline deadline) const {
 
-  if (possibleNumbers.empty()) {
-    return utils::minValidNumber; // Fallback to a known valid number
+  if (candidates.empty()) {
+    // Fallback to a known valid number
+    return {utils::minValidNumber, true, std::nullopt, {}};
   }
 
   // If only one possibility remains, return it
-  if (possibleNumbers.size() == 1) {
-    return possibleNumbers.at(0);
+  if (candidates.size() == 1) {
+    return {candidates.front(), true, std::nullopt, {}};
   }
 
-  int32_t bestGuess{possibleNumbers.at(0)};
-  size_t bestWorstCase{SIZE_MAX};
-
-  // Consider all possible numbers as potential guesses
-  for (size_t i{0}; i < utils::validNumberRange; ++i) {
-    const int32_t candidate{static_cast<int32_t>(i) + utils::minValidNumber};
-    if (!utils::isValidGuess(candidate).has_value()) {
-      continue;
-    }
-
-    // Skip if we've already guessed this number
-    if (history.hasBeenGuessed(candidate)) {
-      continue;
-    }
-
-    if (const size_t worstCase{calculateMinimax(candidate, possibleNumbers)};
-        worstCase < bestWorstCase) {
-      bestWorstCase = worstCase;
-      bestGuess = candidate;
-    }
+  // Consider all unguessed numbers as potential guesses; equivalent guesses
+  // score the same, so only one per symmetry class is evaluated, the most
+  // promising first
+  const SymmetryReducer symmetry{history};
+  const auto order{symmetry.getGuessOrder(candidates, preferred)};
+
+  // Variants without a feedback table partition a whole block of guesses per
+  // pass over the packed candidates
+  if (TiledScorer::isPreferred(candidates)) {
+    const TiledScorer scorer{candidates};
+    const auto scan{utils::parallelRankBlocksUntil<size_t>(
+        std::span<const utils::Rank>{order}, m_workerCount, leaderCount,
+        deadline,
+        [&](size_t, const std::span<const utils::Rank> block,
+            const std::span<std::optional<size_t>> scores) {
+          for (size_t i{0}; i < block.size(); ++i) {
+            scores[i] = m_cache.get(block[i]);
+          }
+          scorer.score(block, scores,
+                       [this](const size_t rank, const Partition& partition) {
+                         const size_t worstCase{partition.worstCase()};
+                         m_cache.cache(rank, worstCase);
+                         return worstCase;
+                       });
+        },
+        std::less{})};
+    return toSelection(scan, candidates.front());
   }
 
-  return bestGuess;
+  // Every guess is scored by exactly one worker, which alone reads and writes
+  // its cache slot
+  const auto scan{utils::parallelRankUntil(
+      std::span<const utils::Rank>{order}, m_workerCount, leaderCount,
+      deadline,
+      [&](size_t, const size_t rank) -> std::optional<size_t> {
+        if (const auto cachedValue{m_cache.get(rank)};
+            cachedValue.has_value()) {
+          return cachedValue;
+        }
+
+        const size_t worstCase{Partition{rank, candidates}.worstCase()};
+        m_cache.cache(rank, worstCase);
+        return worstCase;
+      },
+      std::less{})};
+
+  return toSelection(scan, candidates.front());
 }
 
 std::string_view MinimaxStrategy::getStrategyName() const { return "Minimax"; }
 
 size_t MinimaxStrategy::calculateMinimax(
-    const int32_t guess, const std::vector<int32_t>& possibleNumbers) const {
+    const int32_t guess, const CandidateView& candidates) const {
+
+  const auto guessRank{utils::rank(guess)};
+  if (!guessRank.has_value()) {
+    throw std::invalid_argument("Guess must be a valid number");
+  }
 
   // Check cache first
-  if (const auto cachedValue{m_cache.get(guess)}; cachedValue.has_value()) {
+  if (const auto cachedValue{m_cache.get(guessRank.value())};
+      cachedValue.has_value()) {
     return cachedValue.value();
   }
 
-  if (possibleNumbers.empty()) {
+  if (candidates.empty()) {
     return 0;
   }
 
-  // Count frequency of each possible feedback
-  std::map<std::pair<int32_t, int32_t>, size_t> feedbackCounts;
-
-  for (const int32_t target : possibleNumbers) {
-    const auto [aCount, bCount]{utils::calculateAB(guess, target)};
-    ++feedbackCounts[{aCount, bCount}];
-  }
-
-  // Find the maximum count (worst case)
-  size_t maxCount{0};
-  for (const auto& count : feedbackCounts | std::views::values) {
-    maxCount = std::max(maxCount, count);
-  }
+  // Partition the candidates by feedback and take the largest part
+  const size_t maxCount{Partition{guessRank.value(), candidates}.worstCase()};
 
   // Cache the result
-  m_cache.cache(guess, maxCount);
+  m_cache.cache(guessRank.value(), maxCount);
   return maxCount;
 }
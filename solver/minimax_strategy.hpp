@@ -6,9 +6,9 @@
 #pragma once
 
 #include "../interface/i_guess_strategy.hpp"
+#include "candidate_view.hpp"
 #include "cache_manager.hpp"
 #include "guess_history_manager.hpp"
-#include <vector>
 
 /**
  * @class MinimaxStrategy
@@ -32,14 +32,28 @@ public:
 
   /**
    * @brief Select the best guess using minimax analysis
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @param history Reference to the guess history manager
    * @return The guess that minimizes the worst-case remaining possibilities
    */
   [[nodiscard]] int32_t
-  selectBestGuess(const std::vector<int32_t>& possibleNumbers,
+  selectBestGuess(const CandidateView& candidates,
                   const GuessHistoryManager& history) const override;
 
+  /**
+   * @brief Select a guess, scoring candidates and earlier leaders first
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager
+   * @param preferred Ranks of guesses to score first
+   * @param deadline No further guesses are scored once it has passed
+   * @return The best guess scored before the deadline
+   */
+  [[nodiscard]] Selection
+  selectGuessBefore(const CandidateView& candidates,
+                    const GuessHistoryManager& history,
+                    std::span<const utils::Rank> preferred,
+                    utils::Deadline deadline) const override;
+
   /**
    * @brief Get the name of this strategy
    * @return String identifier for this strategy
@@ -49,13 +63,13 @@ public:
   /**
    * @brief Calculate minimax score for a potential guess
    * @param guess The potential guess to evaluate
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @return Maximum remaining possibilities in worst case (lower values are
    * better)
    */
   [[nodiscard]] size_t
   calculateMinimax(int32_t guess,
-                   const std::vector<int32_t>& possibleNumbers) const;
+                   const CandidateView& candidates) const;
 
 private:
   CacheManager<size_t>&
@@ -0,0 +1,222 @@
+/**
+ * @file number_set.hpp
+ * @brief Fixed-size bitset over number ranks with word-level access
+ */
+
+#pragma once
+
+#include "../utils/number_universe.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+
+/**
+ * @class NumberSet
+ * @brief Set of valid numbers stored as one bit per rank
+ *
+ * Unlike std::bitset, the underlying 64-bit words are exposed so that set
+ * members can be enumerated with std::countr_zero instead of testing every
+ * bit, and so that other components can combine sets word by word.
+ */
+class NumberSet {
+public:
+  using Word = uint64_t; ///< Storage word type
+
+  static constexpr size_t wordBits{64}; ///< Bits per storage word
+  static constexpr size_t wordCount{
+      (utils::validNumberCount + wordBits - 1) / wordBits}; ///< Storage words
+
+  /**
+   * @class Iterator
+   * @brief Forward iterator over the ranks contained in a set
+   */
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = size_t;
+
+    Iterator() = default;
+
+    /**
+     * @brief Construct an iterator positioned at the first member at or after
+     * a word
+     * @param words The words of the set
+     * @param wordIndex Index of the first word to scan
+     */
+    Iterator(const Word* words, const size_t wordIndex)
+        : m_words{words}, m_wordIndex{wordIndex} {
+      if (m_wordIndex < wordCount) {
+        m_bits = m_words[m_wordIndex];
+        skipEmptyWords();
+      }
+    }
+
+    [[nodiscard]] size_t operator*() const {
+      return m_wordIndex * wordBits +
+             static_cast<size_t>(std::countr_zero(m_bits));
+    }
+
+    Iterator& operator++() {
+      m_bits &= m_bits - 1; // Clear lowest set bit
+      skipEmptyWords();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous{*this};
+      ++*this;
+      return previous;
+    }
+
+    [[nodiscard]] bool operator==(const Iterator& other) const {
+      return m_wordIndex == other.m_wordIndex && m_bits == other.m_bits;
+    }
+
+  private:
+    void skipEmptyWords() {
+      while (m_bits == 0 && ++m_wordIndex < wordCount) {
+        m_bits = m_words[m_wordIndex];
+      }
+    }
+
+    const Word* m_words{nullptr}; ///< Words of the set being iterated
+    size_t m_wordIndex{wordCount}; ///< Index of the current word
+    Word m_bits{0};               ///< Remaining bits of the current word
+  };
+
+  /**
+   * @brief Construct an empty set
+   */
+  constexpr NumberSet() = default;
+
+  /**
+   * @brief Construct the set of all valid numbers
+   * @return A set containing every rank
+   */
+  [[nodiscard]] static constexpr NumberSet all() {
+    NumberSet result;
+    result.setAll();
+    return result;
+  }
+
+  constexpr void set(const size_t rank) {
+    m_words[rank / wordBits] |= Word{1} << (rank % wordBits);
+  }
+
+  constexpr void reset(const size_t rank) {
+    m_words[rank / wordBits] &= ~(Word{1} << (rank % wordBits));
+  }
+
+  [[nodiscard]] constexpr bool test(const size_t rank) const {
+    return ((m_words[rank / wordBits] >> (rank % wordBits)) & 1U) != 0;
+  }
+
+  /**
+   * @brief Construct a set from its storage words
+   * @param words Words laid out as returned by words(); bits past the last
+   * rank must be clear
+   * @return The set holding the given bits
+   */
+  [[nodiscard]] static constexpr NumberSet
+  fromWords(const std::span<const Word, wordCount> words) {
+    NumberSet result;
+    std::ranges::copy(words, result.m_words.begin());
+    return result;
+  }
+
+  /**
+   * @brief Add every valid number to the set
+   */
+  constexpr void setAll() {
+    m_words.fill(~Word{0});
+    if constexpr (constexpr size_t tail{utils::validNumberCount % wordBits};
+                  tail != 0) {
+      m_words.back() = (Word{1} << tail) - 1;
+    }
+  }
+
+  /**
+   * @brief Remove every number from the set
+   */
+  constexpr void clear() { m_words.fill(0); }
+
+  [[nodiscard]] constexpr size_t count() const {
+    size_t total{0};
+    for (const Word word : m_words) {
+      total += static_cast<size_t>(std::popcount(word));
+    }
+    return total;
+  }
+
+  [[nodiscard]] constexpr bool none() const {
+    return std::ranges::all_of(m_words, [](const Word word) {
+      return word == 0;
+    });
+  }
+
+  [[nodiscard]] constexpr bool any() const { return !none(); }
+
+  /**
+   * @brief Count the members shared with another set without building it
+   * @param other The set to intersect with
+   * @return Size of the intersection
+   */
+  [[nodiscard]] constexpr size_t
+  countIntersection(const NumberSet& other) const {
+    size_t total{0};
+    for (size_t i{0}; i < wordCount; ++i) {
+      total +=
+          static_cast<size_t>(std::popcount(m_words[i] & other.m_words[i]));
+    }
+    return total;
+  }
+
+  constexpr NumberSet& operator&=(const NumberSet& other) {
+    for (size_t i{0}; i < wordCount; ++i) {
+      m_words[i] &= other.m_words[i];
+    }
+    return *this;
+  }
+
+  constexpr NumberSet& operator|=(const NumberSet& other) {
+    for (size_t i{0}; i < wordCount; ++i) {
+      m_words[i] |= other.m_words[i];
+    }
+    return *this;
+  }
+
+  [[nodiscard]] constexpr bool operator==(const NumberSet&) const = default;
+
+  /**
+   * @brief Invoke a function on every member rank in ascending order
+   * @param fn Callable taking a size_t rank
+   */
+  template <typename Fn> constexpr void forEach(Fn&& fn) const {
+    for (size_t i{0}; i < wordCount; ++i) {
+      for (Word bits{m_words[i]}; bits != 0; bits &= bits - 1) {
+        fn(i * wordBits + static_cast<size_t>(std::countr_zero(bits)));
+      }
+    }
+  }
+
+  [[nodiscard]] Iterator begin() const { return {m_words.data(), 0}; }
+  [[nodiscard]] Iterator end() const { return {}; }
+
+  /**
+   * @brief Get the underlying storage words
+   * @return Span over the words; bit r of the set is bit r % 64 of word r / 64
+   */
+  [[nodiscard]] constexpr std::span<const Word, wordCount> words() const {
+    return m_words;
+  }
+
+private:
+  std::array<Word, wordCount> m_words{}; ///< Bit storage, one bit per rank
+};
@@ -0,0 +1,176 @@
+/**
+ * @file opening_book.cpp
+ * @brief Implementation of OpeningBook class
+ */
+
+#include "opening_book.hpp"
+#include "guess_history_manager.hpp"
+#include "search_space_manager.hpp"
+#include <deque>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/// Layout of book files
+constexpr utils::NodeFile::Format bookFormat{
+    {'1', 'A', '2', 'B', 'B', 'O', 'O', 'K'},
+    OpeningBook::formatVersion,
+    "Opening book"};
+
+/**
+ * @struct Position
+ * @brief A position waiting for its node during generation
+ */
+struct Position {
+  GuessHistoryManager history;    ///< Guesses leading to the position
+  SearchSpaceManager searchSpace; ///< Numbers consistent with history
+  uint32_t turn;                  ///< Guesses made once this one is, from 1
+};
+
+} // namespace
+
+OpeningBook::OpeningBook(const std::filesystem::path& path)
+    : m_file{path, bookFormat} {
+  const auto strategy{StrategySelector::parseStrategy(m_file.getStrategy())};
+  if (!strategy.has_value()) {
+    throw std::runtime_error("Opening book has unknown strategy: " +
+                             path.string());
+  }
+  m_strategy = strategy.value();
+}
+
+std::optional<int32_t>
+OpeningBook::lookup(const GuessHistoryManager& history) const {
+  uint32_t index{0};
+  for (const auto& [guess, feedback] :
+       std::views::zip(history.getGuesses(), history.getFeedback())) {
+    const Node node{m_file.readNode(index)};
+    if (node.guess != guess) {
+      return std::nullopt; // History left the book line
+    }
+
+    const auto [aCount, bCount]{feedback};
+    if (aCount < 0 || bCount < 0 || aCount + bCount > utils::numberSize) {
+      return std::nullopt;
+    }
+    const int8_t bucket{
+        utils::feedbackBuckets[utils::encodeFeedback(aCount, bCount)]};
+    if (bucket < 0) {
+      return std::nullopt;
+    }
+
+    index = node.children[static_cast<size_t>(bucket)];
+    if (index == 0) {
+      return std::nullopt;
+    }
+  }
+
+  return m_file.readNode(index).guess;
+}
+
+std::vector<OpeningBook::Node> OpeningBook::generate(
+    const StrategySelector::StrategyType strategy, const uint32_t depth,
+    const size_t workerCount,
+    const std::span<const std::shared_ptr<const OpeningBook>> openingBooks) {
+  StrategySelector selector{strategy};
+  selector.setWorkerCount(workerCount);
+  for (const auto& book : openingBooks) {
+    selector.addOpeningBook(book);
+  }
+
+  std::vector<Node> nodes;
+  std::deque<Position> pending;
+  if (depth > 0) {
+    nodes.emplace_back();
+    pending.push_back({GuessHistoryManager{}, SearchSpaceManager{}, 1});
+  }
+
+  // Positions are numbered in the order they are queued, which makes the
+  // node array breadth-first
+  for (size_t index{0}; index < nodes.size(); ++index) {
+    const Position position{std::move(pending.front())};
+    pending.pop_front();
+
+    // A single candidate is guessed directly and ends the line
+    if (const auto single{position.searchSpace.getSingleRemaining()};
+        single.has_value()) {
+      nodes[index].guess = single.value();
+      continue;
+    }
+
+    // Cached scores are only valid for the search space they were built for
+    selector.clearCaches();
+    const int32_t guess{selector.selectGuess(
+        position.searchSpace.getCandidates(), position.history)};
+    nodes[index].guess = guess;
+
+    // A guess that tells no candidates apart still grows the history, but the
+    // line would never end if the strategy guessed the same number again
+    if (position.history.hasBeenGuessed(guess)) {
+      throw std::runtime_error(
+          "Strategy repeats a guess and cannot be compiled");
+    }
+    if (position.turn == depth) {
+      continue;
+    }
+
+    for (int32_t aCount{0}; aCount < utils::numberSize; ++aCount) {
+      for (int32_t bCount{0}; aCount + bCount <= utils::numberSize;
+           ++bCount) {
+        const int8_t bucket{
+            utils::feedbackBuckets[utils::encodeFeedback(aCount, bCount)]};
+        if (bucket < 0) {
+          continue;
+        }
+
+        SearchSpaceManager nextSpace{position.searchSpace};
+        nextSpace.applyConstraint(guess, aCount, bCount);
+        if (nextSpace.isEmpty()) {
+          continue;
+        }
+
+        GuessHistoryManager nextHistory{position.history};
+        nextHistory.addGuess(guess, aCount, bCount);
+        nodes[index].children[static_cast<size_t>(bucket)] =
+            static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        pending.push_back({std::move(nextHistory), std::move(nextSpace),
+                           position.turn + 1});
+      }
+    }
+  }
+
+  return nodes;
+}
+
+void OpeningBook::write(const std::filesystem::path& path,
+                        const StrategySelector::StrategyType strategy,
+                        const std::span<const Node> nodes) {
+  utils::NodeFile::write(path, bookFormat, static_cast<uint32_t>(strategy),
+                         nodes);
+}
+
+std::string
+OpeningBook::getFileName(const StrategySelector::StrategyType strategy) {
+  return std::string{StrategySelector::getStrategyKey(strategy)} + "-" +
+         utils::getVariantName() + ".book";
+}
+
+std::vector<std::shared_ptr<const OpeningBook>>
+OpeningBook::loadDirectory(const std::filesystem::path& directory) {
+  std::vector<std::shared_ptr<const OpeningBook>> books;
+  for (const auto strategy : {StrategySelector::StrategyType::entropyBased,
+                              StrategySelector::StrategyType::miniMax,
+                              StrategySelector::StrategyType::frequencyBased,
+                              StrategySelector::StrategyType::hybrid,
+                              StrategySelector::StrategyType::optimal,
+                              StrategySelector::StrategyType::worstCase}) {
+    if (const auto path{directory / getFileName(strategy)};
+        std::filesystem::is_regular_file(path)) {
+      books.push_back(std::make_shared<const OpeningBook>(path));
+    }
+  }
+  return books;
+}
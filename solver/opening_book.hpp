@@ -0,0 +1,127 @@
+/**
+ * @file opening_book.hpp
+ * @brief Precomputed opening guesses stored in a memory-mapped file
+ */
+
+#pragma once
+
+#include "../utils/node_file.hpp"
+#include "../utils/utils.hpp"
+#include "strategy_selector.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+class GuessHistoryManager;
+
+/**
+ * @class OpeningBook
+ * @brief Tree of the guesses a strategy makes on its first turns
+ *
+ * Each node holds the guess chosen at one position and, for every feedback
+ * bucket, the index of the node reached after that feedback (0 when the
+ * position is not in the book). Node 0 is the position with an empty history,
+ * and nodes are stored breadth-first. The file is a utils::NodeFile with the
+ * magic "1A2BBOOK".
+ *
+ * Books are produced offline by the 1a2b_book tool and opened with mmap, so
+ * loading costs a few system calls and lookups touch one node per guess.
+ */
+class OpeningBook {
+public:
+  static constexpr uint32_t formatVersion{1}; ///< Current file format version
+
+  using Node = utils::NodeFile::Node; ///< One position of the book
+
+  /**
+   * @brief Open and validate a book file
+   * @param path Path of the book
+   * @throws std::runtime_error if the file is missing, malformed, written for
+   * another format version, byte order or game variant
+   */
+  explicit OpeningBook(const std::filesystem::path& path);
+
+  /**
+   * @brief Look up the guess for the position reached by a history
+   * @param history The guesses and feedback so far
+   * @return The book guess, or nullopt if the position is not in the book
+   */
+  [[nodiscard]] std::optional<int32_t>
+  lookup(const GuessHistoryManager& history) const;
+
+  /**
+   * @brief Get the strategy whose guesses the book holds
+   * @return The strategy type
+   */
+  [[nodiscard]] StrategySelector::StrategyType getStrategy() const {
+    return m_strategy;
+  }
+
+  /**
+   * @brief Get the maximum number of guesses along a line of the book
+   * @return Depth of the tree
+   */
+  [[nodiscard]] uint32_t getDepth() const { return m_file.getDepth(); }
+
+  /**
+   * @brief Get the number of positions in the book
+   * @return Node count
+   */
+  [[nodiscard]] size_t getNodeCount() const { return m_file.getNodeCount(); }
+
+  /**
+   * @brief Compute the opening tree of a strategy
+   * @param strategy The strategy to record
+   * @param depth Number of guesses to record along each line
+   * @param workerCount Threads used to score guesses, 0 for all
+   * @param openingBooks Books consulted before computing a guess
+   * @return Nodes in file order, breadth-first from the root
+   * @throws std::runtime_error if the strategy guesses a number twice, so
+   * that some line would never end
+   *
+   * A line also ends at a position with a single candidate, whose node holds
+   * that candidate and no children.
+   */
+  [[nodiscard]] static std::vector<Node>
+  generate(StrategySelector::StrategyType strategy, uint32_t depth,
+           size_t workerCount = 0,
+           std::span<const std::shared_ptr<const OpeningBook>> openingBooks =
+               {});
+
+  /**
+   * @brief Write a book file
+   * @param path Destination path
+   * @param strategy The strategy the nodes were generated with
+   * @param nodes Nodes in file order, root first
+   * @throws std::runtime_error if the nodes do not form a tree or the file
+   * cannot be written
+   */
+  static void write(const std::filesystem::path& path,
+                    StrategySelector::StrategyType strategy,
+                    std::span<const Node> nodes);
+
+  /**
+   * @brief Get the conventional file name of a strategy's book
+   * @param strategy The strategy type
+   * @return File name such as "hybrid-4.book"
+   */
+  [[nodiscard]] static std::string
+  getFileName(StrategySelector::StrategyType strategy);
+
+  /**
+   * @brief Open every book found in a directory
+   * @param directory Directory holding files named by getFileName
+   * @return Books that exist for the current variant; missing ones are skipped
+   * @throws std::runtime_error if an existing book is malformed
+   */
+  [[nodiscard]] static std::vector<std::shared_ptr<const OpeningBook>>
+  loadDirectory(const std::filesystem::path& directory);
+
+private:
+  utils::NodeFile m_file;                    ///< Mapped and validated book
+  StrategySelector::StrategyType m_strategy; ///< Strategy of the book
+};
@@ -0,0 +1,40 @@
+/**
+ * @file optimal_strategy.cpp
+ * @brief Implementation of OptimalStrategy class
+ */
+
+#include "optimal_strategy.hpp"
+#include "../utils/number_universe.hpp"
+#include "game_tree_search.hpp"
+
+int32_t
+OptimalStrategy::selectBestGuess(const CandidateView& candidates,
+                                 const GuessHistoryManager& history) const {
+  return selectGuessBefore(candidates, history, {}, utils::Deadline::max())
+      .guess;
+}
+
+IGuessStrategy::Selection OptimalStrategy::selectGuessBefore(
+    const CandidateView& candidates, const GuessHistoryManager& history,
+    std::span<const utils::Rank> /*preferred*/,
+    const utils::Deadline deadline) const {
+
+  if (candidates.empty()) {
+    // Fallback to a known valid number
+    return {utils::minValidNumber, true, std::nullopt, {}};
+  }
+
+  // If only one possibility remains, return it
+  if (candidates.size() == 1) {
+    return {candidates.front(), true, std::nullopt, {}};
+  }
+
+  const auto decision{GameTreeSearch::getInstance().solve(
+      candidates, history, m_workerCount, deadline.stop)};
+  if (!decision.has_value()) {
+    return {candidates.front(), false, std::nullopt, {}}; // Stopped
+  }
+  return {decision->guess, true, std::nullopt, {}};
+}
+
+std::string_view OptimalStrategy::getStrategyName() const { return "Optimal"; }
@@ -0,0 +1,59 @@
+/**
+ * @file optimal_strategy.hpp
+ * @brief Guess selection that minimizes the expected number of guesses
+ */
+
+#pragma once
+
+#include "../interface/i_guess_strategy.hpp"
+#include "candidate_view.hpp"
+#include "guess_history_manager.hpp"
+#include <cstdint>
+
+/**
+ * @class OptimalStrategy
+ * @brief Exact guess selection by game-tree search
+ *
+ * Unlike the one-ply heuristics, this strategy looks ahead to the end of the
+ * game: it picks the guess after which the remaining candidates are found
+ * with the fewest guesses in total, assuming optimal play from then on. Over
+ * all secrets this achieves the optimal average for the game.
+ *
+ * The search is exhaustive and its first calls on a large position can take
+ * a long time; results are memoized by GameTreeSearch for the whole process,
+ * and the opening is best precomputed into an opening book.
+ */
+class OptimalStrategy final : public IGuessStrategy {
+public:
+  /**
+   * @brief Select the guess that minimizes the expected number of guesses
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager
+   * @return The optimal guess
+   */
+  [[nodiscard]] int32_t
+  selectBestGuess(const CandidateView& candidates,
+                  const GuessHistoryManager& history) const override;
+
+  /**
+   * @brief Select the guess of selectBestGuess unless a stop is requested
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager
+   * @param preferred Unused; the search orders guesses itself
+   * @param deadline Its stop request abandons the search; its time does not,
+   * since a search cut short has no best guess so far
+   * @return The guess of selectBestGuess, or an inexact selection of the
+   * first candidate if the search was stopped
+   */
+  [[nodiscard]] Selection
+  selectGuessBefore(const CandidateView& candidates,
+                    const GuessHistoryManager& history,
+                    std::span<const utils::Rank> preferred,
+                    utils::Deadline deadline) const override;
+
+  /**
+   * @brief Get the name of this strategy
+   * @return String identifier for this strategy
+   */
+  [[nodiscard]] std::string_view getStrategyName() const override;
+};
@@ -0,0 +1,82 @@
+/**
+ * @file partition.cpp
+ * @brief Implementation of Partition class
+ */
+
+#include "partition.hpp"
+#include "../utils/number_universe.hpp"
+#include "bit_sliced_universe.hpp"
+#include "feedback_table.hpp"
+#include <algorithm>
+#include <cmath>
+
+Partition::Partition(const size_t guessRank, const CandidateView& candidates)
+    : Partition{[&] {
+        // Count by raw code so the hot loop is a single load and increment
+        CodeCounts codeCounts{};
+        if (candidates.size() > slicedThreshold) {
+          // Dense sets are cheaper to split 64 candidates per word operation
+          codeCounts = BitSlicedUniverse::getInstance().countFeedback(
+              utils::validNumbers[guessRank], candidates.set());
+        } else if constexpr (FeedbackTable::tabulated) {
+          const auto guessCodes{FeedbackTable::getInstance().row(guessRank)};
+          candidates.forEach(
+              [&](const size_t target) { ++codeCounts[guessCodes[target]]; });
+        } else {
+          const FeedbackTable& table{FeedbackTable::getInstance()};
+          candidates.forEach([&](const size_t target) {
+            ++codeCounts[table.code(guessRank, target)];
+          });
+        }
+        return codeCounts;
+      }()} {}
+
+Partition::Partition(const CodeCounts& codeCounts) {
+  for (size_t code{0}; code < utils::feedbackCodeCount; ++code) {
+    if (const int8_t bucket{utils::feedbackBuckets[code]}; bucket >= 0) {
+      m_histogram[static_cast<size_t>(bucket)] = codeCounts[code];
+      m_total += codeCounts[code];
+    }
+  }
+}
+
+double Partition::entropy() const {
+  if (m_total == 0) {
+    return 0.0;
+  }
+
+  // Shannon's formula: H = -Σ(p * log2(p))
+  double entropy{0.0};
+  const auto totalCount{static_cast<double>(m_total)};
+
+  for (const uint32_t count : m_histogram) {
+    if (count > 0) {
+      const double probability{static_cast<double>(count) / totalCount};
+      entropy -= probability * std::log2(probability);
+    }
+  }
+
+  return entropy;
+}
+
+size_t Partition::worstCase() const {
+  return *std::ranges::max_element(m_histogram);
+}
+
+double Partition::expectedSize() const {
+  if (m_total == 0) {
+    return 0.0;
+  }
+
+  uint64_t sumOfSquares{0};
+  for (const uint32_t count : m_histogram) {
+    sumOfSquares += static_cast<uint64_t>(count) * count;
+  }
+
+  return static_cast<double>(sumOfSquares) / static_cast<double>(m_total);
+}
+
+size_t Partition::partCount() const {
+  return static_cast<size_t>(std::ranges::count_if(
+      m_histogram, [](const uint32_t count) { return count > 0; }));
+}
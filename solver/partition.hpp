@@ -0,0 +1,95 @@
+/**
+ * @file partition.hpp
+ * @brief Feedback partition of the candidates induced by one guess
+ */
+
+#pragma once
+
+#include "../utils/utils.hpp"
+#include "candidate_view.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Partition
+ * @brief Histogram of the candidates over the achievable feedback buckets
+ *
+ * A guess splits the candidates into one part per feedback it can receive.
+ * The histogram is filled in a single pass over the candidates using the
+ * feedback table, and every score the strategies need (entropy, worst case,
+ * expected remaining size, number of parts) is derived from its
+ * utils::feedbackBucketCount entries without touching the candidates again.
+ * Sets of more than slicedThreshold candidates are instead split word by word
+ * with BitSlicedUniverse, which costs the same for any density. Variants
+ * without a table score each pair on the fly, and TiledScorer builds the
+ * partitions of whole blocks of guesses from counted codes.
+ */
+class Partition {
+public:
+  using Histogram =
+      std::array<uint32_t, utils::feedbackBucketCount>; ///< Part sizes
+  using CodeCounts =
+      std::array<uint32_t, utils::feedbackCodeCount>; ///< Part sizes by code
+
+  static constexpr size_t slicedThreshold{
+      utils::validNumberCount / 2}; ///< Larger sets are split bit-sliced
+
+  /**
+   * @brief Construct a partition of no candidates
+   */
+  Partition() = default;
+
+  /**
+   * @brief Partition the candidates by their feedback against a guess
+   * @param guessRank Rank of the guess
+   * @param candidates View of the numbers still considered possible
+   */
+  Partition(size_t guessRank, const CandidateView& candidates);
+
+  /**
+   * @brief Build a partition from part sizes counted elsewhere
+   * @param codeCounts Candidates per feedback code, as utils::encodeFeedback
+   */
+  explicit Partition(const CodeCounts& codeCounts);
+
+  /**
+   * @brief Get the size of every part
+   * @return Part sizes indexed by utils::feedbackBuckets
+   */
+  [[nodiscard]] const Histogram& histogram() const { return m_histogram; }
+
+  /**
+   * @brief Get the number of partitioned candidates
+   * @return Sum of all part sizes
+   */
+  [[nodiscard]] size_t total() const { return m_total; }
+
+  /**
+   * @brief Calculate the Shannon entropy of the feedback distribution
+   * @return Entropy in bits (higher is better)
+   */
+  [[nodiscard]] double entropy() const;
+
+  /**
+   * @brief Get the size of the largest part
+   * @return Candidates left after the least informative feedback
+   */
+  [[nodiscard]] size_t worstCase() const;
+
+  /**
+   * @brief Calculate the expected number of remaining candidates
+   * @return Sum of squared part sizes divided by the total
+   */
+  [[nodiscard]] double expectedSize() const;
+
+  /**
+   * @brief Count the non-empty parts
+   * @return Number of distinct feedbacks the guess can receive
+   */
+  [[nodiscard]] size_t partCount() const;
+
+private:
+  Histogram m_histogram{}; ///< Part size per feedback bucket
+  size_t m_total{0};       ///< Number of partitioned candidates
+};
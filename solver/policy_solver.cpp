@@ -0,0 +1,63 @@
+/**
+ * @file policy_solver.cpp
+ * @brief Implementation of PolicySolver class
+ */
+
+#include "policy_solver.hpp"
+#include <stdexcept>
+#include <utility>
+
+PolicySolver::PolicySolver(std::shared_ptr<const PolicyTree> tree)
+    : m_tree{std::move(tree)} {
+  if (!m_tree) {
+    throw std::invalid_argument("Policy tree must not be null");
+  }
+}
+
+std::optional<int32_t> PolicySolver::nextGuess() {
+  if (!m_node.has_value()) {
+    return std::nullopt; // The game left the tree
+  }
+  return m_tree->getGuess(m_node.value());
+}
+
+void PolicySolver::updateGuess(const int32_t guess, const int32_t aCount,
+                               const int32_t bCount) {
+  if (!m_node.has_value() || m_won) {
+    return;
+  }
+  if (guess != m_tree->getGuess(m_node.value()) || aCount < 0 || bCount < 0 ||
+      aCount + bCount > utils::numberSize) {
+    m_node.reset();
+    return;
+  }
+
+  // The correct guess stays the answer
+  if (aCount == utils::numberSize) {
+    m_won = true;
+    return;
+  }
+
+  const int8_t bucket{
+      utils::feedbackBuckets[utils::encodeFeedback(aCount, bCount)]};
+  if (bucket < 0) {
+    m_node.reset();
+    return;
+  }
+  const uint32_t child{
+      m_tree->getChild(m_node.value(), static_cast<size_t>(bucket))};
+  if (child == 0) {
+    m_node.reset(); // No secret gives this feedback
+    return;
+  }
+  m_node = child;
+}
+
+bool PolicySolver::isSolved() const {
+  return m_won || (m_node.has_value() && m_tree->isLeaf(m_node.value()));
+}
+
+void PolicySolver::reset() {
+  m_node = 0;
+  m_won = false;
+}
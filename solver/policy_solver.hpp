@@ -0,0 +1,53 @@
+/**
+ * @file policy_solver.hpp
+ * @brief Solver that replays a compiled policy tree
+ */
+
+#pragma once
+
+#include "../interface/interface.hpp"
+#include "policy_tree.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+/**
+ * @class PolicySolver
+ * @brief Solver that follows a PolicyTree instead of scoring guesses
+ *
+ * The solver keeps the node of the current position, so each guess is one
+ * node read and each feedback one child link. The tree may be shared by any
+ * number of solvers. Feedback that the tree does not cover, such as feedback
+ * for a guess other than the one it suggested or feedback no secret gives,
+ * leaves the tree; nextGuess then returns std::nullopt.
+ */
+class PolicySolver final : public ISolver {
+public:
+  /**
+   * @brief Construct a solver at the start of a game
+   * @param tree The compiled policy to follow
+   * @throws std::invalid_argument if tree is null
+   */
+  explicit PolicySolver(std::shared_ptr<const PolicyTree> tree);
+
+  // ISolver interface implementation
+  std::optional<int32_t> nextGuess() override;
+  void updateGuess(int32_t guess, int32_t aCount, int32_t bCount) override;
+  [[nodiscard]] bool isSolved() const override;
+
+  /**
+   * @brief Return to the start of a game
+   */
+  void reset();
+
+  /**
+   * @brief Get the policy being followed
+   * @return The shared tree
+   */
+  [[nodiscard]] const PolicyTree& getTree() const { return *m_tree; }
+
+private:
+  std::shared_ptr<const PolicyTree> m_tree; ///< Policy being followed
+  std::optional<uint32_t> m_node{0}; ///< Current node, nullopt off the tree
+  bool m_won{false}; ///< Whether the last guess was reported correct
+};
@@ -0,0 +1,64 @@
+/**
+ * @file policy_tree.cpp
+ * @brief Implementation of PolicyTree class
+ */
+
+#include "policy_tree.hpp"
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/// Layout of policy files
+constexpr utils::NodeFile::Format policyFormat{
+    {'1', 'A', '2', 'B', 'P', 'L', 'C', 'Y'},
+    PolicyTree::formatVersion,
+    "Policy"};
+
+} // namespace
+
+PolicyTree::PolicyTree(const std::filesystem::path& path)
+    : m_file{path, policyFormat} {
+  const auto strategy{StrategySelector::parseStrategy(m_file.getStrategy())};
+  if (!strategy.has_value()) {
+    throw std::runtime_error("Policy has unknown strategy: " + path.string());
+  }
+  m_strategy = strategy.value();
+}
+
+int32_t PolicyTree::getGuess(const uint32_t index) const {
+  return static_cast<int32_t>(m_file.readField(index, 0));
+}
+
+uint32_t PolicyTree::getChild(const uint32_t index, const size_t bucket) const {
+  return m_file.readField(index, 1 + bucket);
+}
+
+bool PolicyTree::isLeaf(const uint32_t index) const {
+  for (size_t bucket{0}; bucket < utils::feedbackBucketCount; ++bucket) {
+    if (getChild(index, bucket) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<PolicyTree::Node> PolicyTree::compile(
+    const StrategySelector::StrategyType strategy, const size_t workerCount,
+    const std::span<const std::shared_ptr<const OpeningBook>> openingBooks) {
+  return OpeningBook::generate(strategy, std::numeric_limits<uint32_t>::max(),
+                               workerCount, openingBooks);
+}
+
+void PolicyTree::write(const std::filesystem::path& path,
+                       const StrategySelector::StrategyType strategy,
+                       const std::span<const Node> nodes) {
+  utils::NodeFile::write(path, policyFormat, static_cast<uint32_t>(strategy),
+                         nodes);
+}
+
+std::string
+PolicyTree::getFileName(const StrategySelector::StrategyType strategy) {
+  return std::string{StrategySelector::getStrategyKey(strategy)} + "-" +
+         utils::getVariantName() + ".policy";
+}
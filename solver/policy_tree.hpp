@@ -0,0 +1,131 @@
+/**
+ * @file policy_tree.hpp
+ * @brief A strategy's complete decision tree stored in a memory-mapped file
+ */
+
+#pragma once
+
+#include "../utils/node_file.hpp"
+#include "../utils/utils.hpp"
+#include "opening_book.hpp"
+#include "strategy_selector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @class PolicyTree
+ * @brief Every guess a deterministic strategy makes, for every secret
+ *
+ * A strategy that always picks the same guess at the same position is fully
+ * described by the tree of positions it reaches. A policy is an opening book
+ * that is not cut off at a depth: every line ends at a node whose guess is
+ * the only remaining candidate, so a game is served from the tree alone.
+ *
+ * A node without children is a position with a single candidate, its guess.
+ * Nodes are stored breadth-first, so the first guesses of every game share
+ * the first few cache lines and pages. The file is a utils::NodeFile with the
+ * magic "1A2BPLCY".
+ *
+ * Trees are compiled offline by the 1a2b_policy tool and opened with mmap.
+ */
+class PolicyTree {
+public:
+  static constexpr uint32_t formatVersion{1}; ///< Current file format version
+
+  using Node = OpeningBook::Node; ///< One position of the tree
+
+  /**
+   * @brief Open and validate a policy file
+   * @param path Path of the policy
+   * @throws std::runtime_error if the file is missing, malformed, written for
+   * another format version, byte order, game variant or an unknown strategy
+   */
+  explicit PolicyTree(const std::filesystem::path& path);
+
+  /**
+   * @brief Get the guess made at a node
+   * @param index Node index, 0 for the start of the game
+   * @return The guess
+   */
+  [[nodiscard]] int32_t getGuess(uint32_t index) const;
+
+  /**
+   * @brief Get the node reached after a feedback
+   * @param index Node index
+   * @param bucket Feedback bucket, see utils::feedbackBuckets
+   * @return Index of the next node, 0 if there is none
+   */
+  [[nodiscard]] uint32_t getChild(uint32_t index, size_t bucket) const;
+
+  /**
+   * @brief Check whether a node's guess is its only candidate
+   * @param index Node index
+   * @return true if no feedback leads on from the node
+   */
+  [[nodiscard]] bool isLeaf(uint32_t index) const;
+
+  /**
+   * @brief Get the strategy whose guesses the tree holds
+   * @return The strategy type
+   */
+  [[nodiscard]] StrategySelector::StrategyType getStrategy() const {
+    return m_strategy;
+  }
+
+  /**
+   * @brief Get the most guesses the strategy needs for any secret
+   * @return Depth of the tree
+   */
+  [[nodiscard]] uint32_t getDepth() const { return m_file.getDepth(); }
+
+  /**
+   * @brief Get the number of positions in the tree
+   * @return Node count
+   */
+  [[nodiscard]] size_t getNodeCount() const { return m_file.getNodeCount(); }
+
+  /**
+   * @brief Expand a strategy over every secret
+   * @param strategy The strategy to record
+   * @param workerCount Threads used to score guesses, 0 for all
+   * @param openingBooks Books consulted before computing a guess
+   * @return Nodes in file order, breadth-first from the root
+   * @throws std::runtime_error if the strategy guesses a number twice, so
+   * that some game would never end
+   *
+   * This is OpeningBook::generate without a depth limit.
+   */
+  [[nodiscard]] static std::vector<Node>
+  compile(StrategySelector::StrategyType strategy, size_t workerCount = 0,
+          std::span<const std::shared_ptr<const OpeningBook>> openingBooks =
+              {});
+
+  /**
+   * @brief Write a policy file
+   * @param path Destination path
+   * @param strategy The strategy the nodes were compiled from
+   * @param nodes Nodes in file order, root first
+   * @throws std::runtime_error if the nodes do not form a tree or the file
+   * cannot be written
+   */
+  static void write(const std::filesystem::path& path,
+                    StrategySelector::StrategyType strategy,
+                    std::span<const Node> nodes);
+
+  /**
+   * @brief Get the conventional file name of a strategy's policy
+   * @param strategy The strategy type
+   * @return File name such as "hybrid-4.policy"
+   */
+  [[nodiscard]] static std::string
+  getFileName(StrategySelector::StrategyType strategy);
+
+private:
+  utils::NodeFile m_file;                    ///< Mapped and validated policy
+  StrategySelector::StrategyType m_strategy; ///< Strategy of the tree
+};
@@ -4,67 +4,104 @@
  */
 
 #include "search_space_manager.hpp"
-#include "../utils/utils.hpp"
+#include "bit_sliced_universe.hpp"
+#include "feedback_table.hpp"
+#include "guess_history_manager.hpp"
+#include <algorithm>
+#include <numeric>
+#include <ranges>
 
 SearchSpaceManager::SearchSpaceManager() {
-  m_possibleNumbers.set(); // Initialize all numbers as possible
+  m_possibleRanks.reserve(utils::validNumberCount);
+  reset(); // Initialize all numbers as possible
+}
 
-  // Clear invalid numbers
-  for (size_t i{0}; i < utils::validNumberRange; ++i) {
-    if (const int32_t number{indexToNumber(i)};
-        !utils::isValidGuess(number).has_value()) {
-      m_possibleNumbers.reset(i);
-    }
-  }
+void SearchSpaceManager::reset() {
+  m_possibleNumbers.setAll();
+  m_possibleRanks.resize(utils::validNumberCount);
+  std::iota(m_possibleRanks.begin(), m_possibleRanks.end(), utils::Rank{0});
 }
 
 void SearchSpaceManager::eliminateNumber(const int32_t number) {
-  if (utils::isValidGuess(number).has_value()) {
-    m_possibleNumbers.reset(numberToIndex(number));
+  if (const auto index{utils::rank(number)}; index.has_value()) {
+    m_possibleNumbers.reset(index.value());
+    compactRanks();
   }
 }
 
 void SearchSpaceManager::applyConstraint(const int32_t guess,
                                          const int32_t aCount,
                                          const int32_t bCount) {
-  // Use constraint propagation to eliminate impossible numbers
-  for (size_t i{0}; i < utils::validNumberRange; ++i) {
-    if (!m_possibleNumbers.test(i)) {
-      continue; // Already eliminated
-    }
+  intersectConstraint(m_possibleNumbers, guess, aCount, bCount);
+  compactRanks();
+}
 
-    const int32_t candidate{indexToNumber(i)};
+void SearchSpaceManager::intersectConstraint(NumberSet& numbers,
+                                             const int32_t guess,
+                                             const int32_t aCount,
+                                             const int32_t bCount) {
+  // No number can produce feedback outside the valid range
+  if (aCount < 0 || bCount < 0 || aCount + bCount > utils::numberSize) {
+    numbers.clear();
+    return;
+  }
 
+  // Intersect with the numbers giving this feedback, computed word by word
+  if (BitSlicedUniverse::isSliceable(guess)) {
+    numbers &=
+        BitSlicedUniverse::getInstance().consistentWith(guess, aCount, bCount);
+    return;
+  }
+
+  // Repeated digits break the sliced counts, so check each candidate
+  const uint8_t expected{utils::encodeFeedback(aCount, bCount)};
+  const FeedbackTable& table{FeedbackTable::getInstance()};
+  numbers.forEach([&](const size_t rank) {
     // If this candidate produce different feedback, eliminate it
-    if (const auto [candidateA,
-                    candidateB]{utils::calculateAB(guess, candidate)};
-        candidateA != aCount || candidateB != bCount) {
-      m_possibleNumbers.reset(i);
+    if (table.lookup(guess, utils::unrank(rank)) != expected) {
+      numbers.reset(rank);
     }
+  });
+}
+
+void SearchSpaceManager::compactRanks() {
+  std::erase_if(m_possibleRanks, [this](const utils::Rank rank) {
+    return !m_possibleNumbers.test(rank);
+  });
+}
+
+void SearchSpaceManager::applyHistory(const GuessHistoryManager& history) {
+  for (const auto& [guess, feedback] :
+       std::views::zip(history.getGuesses(), history.getFeedback())) {
+    intersectConstraint(m_possibleNumbers, guess, feedback.first,
+                        feedback.second);
   }
+  compactRanks();
 }
 
 std::vector<int32_t> SearchSpaceManager::getPossibleNumbers() const {
   std::vector<int32_t> result;
-  result.reserve(m_possibleNumbers.count());
+  result.reserve(m_possibleRanks.size());
 
-  for (size_t i{0}; i < utils::validNumberRange; ++i) {
-    if (m_possibleNumbers.test(i)) {
-      result.push_back(indexToNumber(i));
-    }
+  for (const utils::Rank rank : m_possibleRanks) {
+    result.push_back(utils::unrank(rank));
   }
 
   return result;
 }
 
+CandidateView SearchSpaceManager::getCandidates() const {
+  return {m_possibleNumbers, m_possibleRanks};
+}
+
 size_t SearchSpaceManager::getRemainingCount() const {
-  return m_possibleNumbers.count();
+  return m_possibleRanks.size();
 }
 
-bool SearchSpaceManager::isEmpty() const { return m_possibleNumbers.none(); }
+bool SearchSpaceManager::isEmpty() const { return m_possibleRanks.empty(); }
 
 bool SearchSpaceManager::hasOnlyOne() const {
-  return m_possibleNumbers.count() == 1;
+  return m_possibleRanks.size() == 1;
 }
 
 std::optional<int32_t> SearchSpaceManager::getSingleRemaining() const {
@@ -72,19 +109,5 @@ std::optional<int32_t> SearchSpaceManager::getSingleRemaining() const {
     return std::nullopt;
   }
 
-  for (size_t i{0}; i < utils::validNumberRange; ++i) {
-    if (m_possibleNumbers.test(i)) {
-      return indexToNumber(i);
-    }
-  }
-
-  return std::nullopt; // Should never reach here if hasOnlyOne() is true
-}
-
-int32_t SearchSpaceManager::indexToNumber(const size_t index) {
-  return static_cast<int32_t>(index) + utils::minValidNumber;
-}
-
-size_t SearchSpaceManager::numberToIndex(const int32_t number) {
-  return static_cast<size_t>(number - utils::minValidNumber);
+  return utils::unrank(m_possibleRanks.front());
 }
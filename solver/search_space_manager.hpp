@@ -5,11 +5,16 @@
 
 #pragma once
 
-#include "../utils/utils.hpp"
-#include <bitset>
+#include "../utils/number_universe.hpp"
+#include "candidate_view.hpp"
+#include "number_set.hpp"
+#include <cstdint>
 #include <optional>
 #include <vector>
 
+// Forward declaration
+class GuessHistoryManager;
+
 /**
  * @class SearchSpaceManager
  * @brief Manages the set of possible numbers and constraint propagation
@@ -25,6 +30,11 @@ public:
    */
   explicit SearchSpaceManager();
 
+  /**
+   * @brief Restore the search space to all valid numbers
+   */
+  void reset();
+
   /**
    * @brief Eliminate a specific number from the search space
    * @param number The number to eliminate
@@ -40,12 +50,41 @@ public:
    */
   void applyConstraint(int32_t guess, int32_t aCount, int32_t bCount);
 
+  /**
+   * @brief Apply the constraints of every guess in a history
+   * @param history The guesses and feedback to replay
+   *
+   * Each guess costs a fixed number of word operations on bit-sliced digit
+   * masks, which makes rebuilding a resumed session from its history cheap.
+   */
+  void applyHistory(const GuessHistoryManager& history);
+
+  /**
+   * @brief Remove the numbers inconsistent with a guess's feedback from a set
+   * @param numbers The set to narrow
+   * @param guess The guess that was made
+   * @param aCount Number of correct digits in correct positions
+   * @param bCount Number of correct digits in wrong positions
+   *
+   * Lets owners of a bare NumberSet, such as SolverSession, narrow it the
+   * same way as the search space without keeping a rank list.
+   */
+  static void intersectConstraint(NumberSet& numbers, int32_t guess,
+                                  int32_t aCount, int32_t bCount);
+
   /**
    * @brief Get all currently possible numbers as a vector
    * @return Vector containing all numbers still considered possible
    */
   [[nodiscard]] std::vector<int32_t> getPossibleNumbers() const;
 
+  /**
+   * @brief Get a non-owning view of the possible numbers
+   * @return View over the membership bitset and the dense rank list
+   * @note The view is invalidated by any modification of the search space
+   */
+  [[nodiscard]] CandidateView getCandidates() const;
+
   /**
    * @brief Get the count of remaining possible numbers
    * @return Number of possibilities still in the search space
@@ -71,20 +110,12 @@ public:
   [[nodiscard]] std::optional<int32_t> getSingleRemaining() const;
 
 private:
-  std::bitset<utils::validNumberRange>
-      m_possibleNumbers; ///< Bitset tracking possible numbers
-
-  /**
-   * @brief Convert bitset index to actual number
-   * @param index Index in the bitset
-   * @return Corresponding number
-   */
-  [[nodiscard]] static int32_t indexToNumber(size_t index);
+  NumberSet m_possibleNumbers; ///< Bitset tracking possible numbers by rank
+  std::vector<utils::Rank>
+      m_possibleRanks; ///< Ascending ranks of m_possibleNumbers members
 
   /**
-   * @brief Convert number to bitset index
-   * @param number The number to convert
-   * @return Corresponding index in bitset
+   * @brief Drop ranks that are no longer in the bitset from the rank list
    */
-  [[nodiscard]] static size_t numberToIndex(int32_t number);
+  void compactRanks();
 };
@@ -0,0 +1,101 @@
+/**
+ * @file set_memo.cpp
+ * @brief Implementation of SetMemo class
+ */
+
+#include "set_memo.hpp"
+#include "../utils/number_universe.hpp"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+std::vector<utils::Rank>
+SetMemo::canonicalize(const std::span<const utils::Rank> set) {
+  // Describe every digit by how often it occurs at each position
+  std::array<std::array<uint32_t, utils::numberSize>, utils::alphabetSize>
+      occurrences{};
+  for (const utils::Rank rank : set) {
+    const uint32_t packed{utils::packedDigits[rank]};
+    for (size_t pos{0}; pos < utils::numberSize; ++pos) {
+      ++occurrences[utils::packedDigitAt(packed, pos)][pos];
+    }
+  }
+
+  // Zero stays in place because it cannot lead a number
+  std::array<uint8_t, utils::alphabetSize - 1> digits{};
+  std::iota(digits.begin(), digits.end(), uint8_t{1});
+  std::ranges::sort(digits, [&occurrences](const uint8_t lhs,
+                                           const uint8_t rhs) {
+    return occurrences[lhs] != occurrences[rhs]
+               ? occurrences[lhs] < occurrences[rhs]
+               : lhs < rhs;
+  });
+  std::array<int32_t, utils::alphabetSize> relabel{};
+  for (size_t i{0}; i < digits.size(); ++i) {
+    relabel[digits[i]] = static_cast<int32_t>(i + 1);
+  }
+
+  std::vector<utils::Rank> key;
+  key.reserve(set.size());
+  for (const utils::Rank rank : set) {
+    const uint32_t packed{utils::packedDigits[rank]};
+    int32_t number{0};
+    for (size_t pos{0}; pos < utils::numberSize; ++pos) {
+      number = number * utils::alphabetSize +
+               relabel[utils::packedDigitAt(packed, pos)];
+    }
+    key.push_back(static_cast<utils::Rank>(utils::rank(number).value()));
+  }
+  std::ranges::sort(key);
+  return key;
+}
+
+std::optional<SetMemo::Bound>
+SetMemo::lookup(const std::vector<utils::Rank>& key) const {
+  Shard& shard{m_shards[KeyHash{}(key) % shardCount]};
+  const std::scoped_lock lock{shard.mutex};
+  if (const auto it{shard.entries.find(key)}; it != shard.entries.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+void SetMemo::store(std::vector<utils::Rank> key, const Bound bound) const {
+  Shard& shard{m_shards[KeyHash{}(key) % shardCount]};
+  const std::scoped_lock lock{shard.mutex};
+  if (const auto it{shard.entries.find(key)}; it != shard.entries.end()) {
+    Bound& known{it->second};
+    if (!known.exact && (bound.exact || bound.cost > known.cost)) {
+      known = bound;
+    }
+    return;
+  }
+  if (shard.entries.size() < capacity / shardCount) {
+    shard.entries.emplace(std::move(key), bound);
+  }
+}
+
+size_t SetMemo::size() const {
+  size_t total{0};
+  for (Shard& shard : m_shards) {
+    const std::scoped_lock lock{shard.mutex};
+    total += shard.entries.size();
+  }
+  return total;
+}
+
+void SetMemo::clear() {
+  for (Shard& shard : m_shards) {
+    const std::scoped_lock lock{shard.mutex};
+    shard.entries.clear();
+  }
+}
+
+size_t SetMemo::KeyHash::operator()(const std::vector<utils::Rank>& key) const {
+  // FNV-1a over the ranks
+  uint64_t hash{14695981039346656037ULL};
+  for (const utils::Rank rank : key) {
+    hash = (hash ^ rank) * 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file set_memo.hpp
+ * @brief Thread-safe memo of search results keyed by canonical candidate sets
+ */
+
+#pragma once
+
+#include "../utils/number_universe.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SetMemo
+ * @brief Bounds on a search result by candidate set
+ *
+ * Relabeling non-zero digits maps a set of candidates onto one that is played
+ * exactly alike, so sets are stored under a canonical form in which digits are
+ * renamed in order of their per-position counts. An entry is either the exact
+ * result or a lower bound on it, and stronger knowledge replaces weaker. The
+ * memo is sliced into lock-protected shards and stops growing at a fixed
+ * capacity.
+ */
+class SetMemo {
+public:
+  /**
+   * @struct Bound
+   * @brief Memoized knowledge of the result for a set
+   */
+  struct Bound {
+    uint64_t cost; ///< The result, or a lower bound on it
+    bool exact;    ///< Whether cost is exact
+  };
+
+  /**
+   * @brief Rename digits so that equivalent sets get the same key
+   * @param set Ascending ranks of the candidates
+   * @return Ascending ranks of the relabeled candidates
+   */
+  [[nodiscard]] static std::vector<utils::Rank>
+  canonicalize(std::span<const utils::Rank> set);
+
+  /**
+   * @brief Look up what is known about a set
+   * @param key Canonical set
+   * @return The memoized bound, if any
+   */
+  [[nodiscard]] std::optional<Bound>
+  lookup(const std::vector<utils::Rank>& key) const;
+
+  /**
+   * @brief Record what was learned about a set
+   * @param key Canonical set
+   * @param bound Exact result or lower bound; weaker knowledge is ignored
+   */
+  void store(std::vector<utils::Rank> key, Bound bound) const;
+
+  /**
+   * @brief Get the number of memoized sets
+   * @return Entries in the memo
+   */
+  [[nodiscard]] size_t size() const;
+
+  /**
+   * @brief Forget every memoized set
+   */
+  void clear();
+
+private:
+  /**
+   * @struct KeyHash
+   * @brief Hash of a canonical set
+   */
+  struct KeyHash {
+    [[nodiscard]] size_t operator()(const std::vector<utils::Rank>& key) const;
+  };
+
+  /**
+   * @struct Shard
+   * @brief One lock-protected slice of the memo
+   */
+  struct Shard {
+    std::mutex mutex; ///< Guards entries
+    std::unordered_map<std::vector<utils::Rank>, Bound, KeyHash>
+        entries; ///< Bounds by canonical set
+  };
+
+  static constexpr size_t shardCount{64}; ///< Memo slices
+  static constexpr size_t capacity{
+      size_t{1} << 22}; ///< Maximum memoized sets; further sets are not stored
+
+  mutable std::array<Shard, shardCount> m_shards; ///< Memo, sliced by hash
+};
@@ -0,0 +1,76 @@
+/**
+ * @file solver_engine.cpp
+ * @brief Implementation of SolverEngine class
+ */
+
+#include "solver_engine.hpp"
+#include "bit_sliced_universe.hpp"
+#include "candidate_view.hpp"
+#include "feedback_table.hpp"
+#include "guess_history_manager.hpp"
+#include <atomic>
+#include <utility>
+
+namespace {
+
+std::atomic<uint64_t> nextEngineId{1}; ///< Id of the next engine built
+
+/**
+ * @struct ThreadState
+ * @brief Scratch objects of one thread, reused for every guess
+ */
+struct ThreadState {
+  uint64_t engineId{0};        ///< Engine the selector is configured for
+  StrategySelector selector;   ///< Selector of the thread
+  GuessHistoryManager history; ///< Turns of the session being guessed for
+};
+
+thread_local ThreadState threadState; ///< Scratch of the calling thread
+
+} // namespace
+
+SolverEngine::SolverEngine() : SolverEngine{Options{}} {}
+
+SolverEngine::SolverEngine(Options options)
+    : m_options{std::move(options)}, m_id{nextEngineId++} {
+  // Pay for the tables now rather than in the first session's first guess
+  [[maybe_unused]] const FeedbackTable& table{FeedbackTable::getInstance()};
+  [[maybe_unused]] const BitSlicedUniverse& universe{
+      BitSlicedUniverse::getInstance()};
+}
+
+std::optional<int32_t>
+SolverEngine::nextGuess(const SolverSession& session) const {
+  const NumberSet& candidates{session.getCandidates()};
+  const size_t remaining{candidates.count()};
+  if (remaining == 0) {
+    return std::nullopt; // No valid guesses left
+  }
+
+  // If only one possibility remains, return it
+  if (remaining == 1) {
+    return utils::unrank(*candidates.begin());
+  }
+
+  StrategySelector& selector{getThreadSelector()};
+  selector.setStrategy(session.getStrategy());
+
+  // The caches hold scores for whichever session the thread served last
+  selector.clearCaches();
+  session.copyHistoryTo(threadState.history);
+  return selector.selectGuess(CandidateView{candidates}, threadState.history);
+}
+
+StrategySelector& SolverEngine::getThreadSelector() const {
+  if (threadState.engineId != m_id) {
+    StrategySelector selector;
+    selector.setWorkerCount(m_options.workerCount);
+    selector.setEntropySampling(m_options.entropySampling);
+    for (const auto& book : m_options.openingBooks) {
+      selector.addOpeningBook(book);
+    }
+    threadState.selector = std::move(selector);
+    threadState.engineId = m_id;
+  }
+  return threadState.selector;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file solver_engine.hpp
+ * @brief Guess selection shared read-only by any number of game sessions
+ */
+
+#pragma once
+
+#include "entropy_race.hpp"
+#include "solver_session.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+class OpeningBook;
+
+/**
+ * @class SolverEngine
+ * @brief Immutable solver configuration that computes guesses for sessions
+ *
+ * The precomputed tables (FeedbackTable, BitSlicedUniverse) and the memos
+ * (TranspositionTable, GameTreeSearch, WorstCaseSearch) are process-wide
+ * already; the engine builds the tables when it is constructed and adds the
+ * settings every game shares, so that a game itself is just a SolverSession.
+ *
+ * The engine never changes after construction and may be used by any number
+ * of threads at once. Each thread selects guesses with a StrategySelector of
+ * its own, created on its first guess and kept for the life of the thread, so
+ * scoring caches exist once per thread rather than once per game.
+ */
+class SolverEngine {
+public:
+  /**
+   * @struct Options
+   * @brief Settings shared by every session
+   */
+  struct Options {
+    size_t workerCount{1}; ///< Threads scoring one guess, 0 for all
+    std::optional<EntropySampling>
+        entropySampling; ///< Approximate entropy settings, if enabled
+    std::vector<std::shared_ptr<const OpeningBook>>
+        openingBooks; ///< Books consulted before computing a guess
+  };
+
+  /**
+   * @brief Build the shared tables with the default settings
+   */
+  SolverEngine();
+
+  /**
+   * @brief Build the shared tables and fix the settings
+   * @param options Settings shared by every session
+   */
+  explicit SolverEngine(Options options);
+
+  SolverEngine(const SolverEngine&) = delete;
+  SolverEngine& operator=(const SolverEngine&) = delete;
+
+  /**
+   * @brief Get the next guess of a session
+   * @param session The game to guess for
+   * @return The guess a HeuristicSolver with the same settings, strategy and
+   * feedback would make, or nullopt if no candidates remain
+   */
+  [[nodiscard]] std::optional<int32_t>
+  nextGuess(const SolverSession& session) const;
+
+  /**
+   * @brief Get the settings shared by every session
+   * @return The options given at construction
+   */
+  [[nodiscard]] const Options& getOptions() const { return m_options; }
+
+private:
+  /**
+   * @brief Get the calling thread's selector, configured for this engine
+   * @return Selector owned by the calling thread
+   */
+  [[nodiscard]] StrategySelector& getThreadSelector() const;
+
+  Options m_options; ///< Settings shared by every session
+  uint64_t m_id;     ///< Tells engines apart in the per-thread selectors
+};
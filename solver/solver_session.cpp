@@ -0,0 +1,29 @@
+/**
+ * @file solver_session.cpp
+ * @brief Implementation of SolverSession class
+ */
+
+#include "solver_session.hpp"
+#include "guess_history_manager.hpp"
+#include "search_space_manager.hpp"
+#include <algorithm>
+
+SolverSession::SolverSession(const StrategySelector::StrategyType strategy)
+    : m_candidates{NumberSet::all()}, m_strategy{strategy} {}
+
+void SolverSession::updateGuess(const int32_t guess, const int32_t aCount,
+                                const int32_t bCount) {
+  SearchSpaceManager::intersectConstraint(m_candidates, guess, aCount, bCount);
+
+  // Feedback outside the valid range has already emptied the candidates, so
+  // clamping it only keeps the record short
+  m_turns.push_back({guess, static_cast<int8_t>(std::clamp(aCount, -1, 127)),
+                     static_cast<int8_t>(std::clamp(bCount, -1, 127))});
+}
+
+void SolverSession::copyHistoryTo(GuessHistoryManager& history) const {
+  history.clear();
+  for (const Turn& turn : m_turns) {
+    history.addGuess(turn.guess, turn.aCount, turn.bCount);
+  }
+}
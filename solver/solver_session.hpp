@@ -0,0 +1,104 @@
+/**
+ * @file solver_session.hpp
+ * @brief Compact state of one game whose guesses come from a SolverEngine
+ */
+
+#pragma once
+
+#include "number_set.hpp"
+#include "strategy_selector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class GuessHistoryManager;
+
+/**
+ * @class SolverSession
+ * @brief The candidates and turns of one game, without any solver machinery
+ *
+ * A HeuristicSolver carries a strategy selector, scoring caches and a rank
+ * list, which is right for one game at a time but far too much to keep for
+ * every idle game of a server. A session keeps only what differs between
+ * games: the candidate bitset, the turns played and the strategy. Guesses are
+ * computed by a shared SolverEngine, and pick the same numbers as a
+ * HeuristicSolver fed the same feedback.
+ *
+ * A session takes one bit per valid number, 568 bytes for the standard game,
+ * plus 8 bytes per turn.
+ */
+class SolverSession {
+public:
+  /**
+   * @struct Turn
+   * @brief A guess and the feedback it got
+   */
+  struct Turn {
+    int32_t guess; ///< The number that was guessed
+    int8_t aCount; ///< Correct digits in correct positions
+    int8_t bCount; ///< Correct digits in wrong positions
+  };
+
+  /**
+   * @brief Start a game with every valid number possible
+   * @param strategy Strategy the engine selects guesses with
+   */
+  explicit SolverSession(StrategySelector::StrategyType strategy =
+                             StrategySelector::StrategyType::hybrid);
+
+  /**
+   * @brief Record the feedback on a guess and drop inconsistent candidates
+   * @param guess The number that was guessed
+   * @param aCount Number of correct digits in correct positions
+   * @param bCount Number of correct digits in wrong positions
+   */
+  void updateGuess(int32_t guess, int32_t aCount, int32_t bCount);
+
+  /**
+   * @brief Get the numbers still considered possible
+   * @return The candidate bitset
+   */
+  [[nodiscard]] const NumberSet& getCandidates() const { return m_candidates; }
+
+  /**
+   * @brief Get the number of remaining possible numbers
+   * @return Count of candidates
+   */
+  [[nodiscard]] size_t getRemainingCount() const {
+    return m_candidates.count();
+  }
+
+  /**
+   * @brief Get the turns played so far
+   * @return Turns in the order they were played
+   */
+  [[nodiscard]] std::span<const Turn> getTurns() const { return m_turns; }
+
+  /**
+   * @brief Copy the turns into a guess history
+   * @param history History to overwrite
+   */
+  void copyHistoryTo(GuessHistoryManager& history) const;
+
+  /**
+   * @brief Get the strategy guesses are selected with
+   * @return The strategy type
+   */
+  [[nodiscard]] StrategySelector::StrategyType getStrategy() const {
+    return m_strategy;
+  }
+
+  /**
+   * @brief Set the strategy guesses are selected with
+   * @param strategy The strategy type
+   */
+  void setStrategy(const StrategySelector::StrategyType strategy) {
+    m_strategy = strategy;
+  }
+
+private:
+  NumberSet m_candidates;                    ///< Numbers consistent with turns
+  std::vector<Turn> m_turns;                 ///< Guesses and their feedback
+  StrategySelector::StrategyType m_strategy; ///< Strategy of the game
+};
@@ -4,21 +4,79 @@
  */
 
 #include "strategy_selector.hpp"
+#include "opening_book.hpp"
+#include "transposition_table.hpp"
+#include <bit>
+#include <initializer_list>
+#include <ranges>
 #include <stdexcept>
+#include <utility>
 
 StrategySelector::StrategySelector(const StrategyType defaultStrategy)
-    : m_currentStrategy{defaultStrategy} {
-  initializeStrategies();
-}
+    : m_currentStrategy{defaultStrategy} {}
 
 int32_t
-StrategySelector::selectGuess(const std::vector<int32_t>& possibleNumbers,
+StrategySelector::selectGuess(const CandidateView& candidates,
                               const GuessHistoryManager& history) const {
 
-  return getCurrentStrategy().selectBestGuess(possibleNumbers, history);
+  // Positions covered by an opening book need no computation
+  if (const auto guess{lookupOpeningBooks(history)}; guess.has_value()) {
+    return guess.value();
+  }
+
+  if (!m_useTranspositions) {
+    return getCurrentStrategy().selectBestGuess(candidates, history);
+  }
+
+  // Positions any solver in the process has seen cost a lookup
+  const TranspositionTable& table{TranspositionTable::getInstance()};
+  const uint64_t key{TranspositionTable::fingerprint(
+      candidates.set(), history, getTranspositionSalt())};
+  if (const auto entry{table.lookup(key)}; entry.has_value()) {
+    return entry->guess;
+  }
+
+  const IGuessStrategy::Selection selection{
+      getCurrentStrategy().selectGuessBefore(candidates, history, {},
+                                             utils::Deadline::max())};
+  table.store(key, {selection.guess, selection.score});
+  return selection.guess;
+}
+
+IGuessStrategy::Selection
+StrategySelector::selectGuessBefore(const CandidateView& candidates,
+                                    const GuessHistoryManager& history,
+                                    const utils::Deadline deadline) {
+
+  if (const auto guess{lookupOpeningBooks(history)}; guess.has_value()) {
+    return {guess.value(), true, std::nullopt, {}};
+  }
+
+  const TranspositionTable& table{TranspositionTable::getInstance()};
+  std::optional<uint64_t> key;
+  if (m_useTranspositions) {
+    key = TranspositionTable::fingerprint(candidates.set(), history,
+                                          getTranspositionSalt());
+    if (const auto entry{table.lookup(key.value())}; entry.has_value()) {
+      return {entry->guess, true, entry->score, {}};
+    }
+  }
+
+  IGuessStrategy::Selection selection{getCurrentStrategy().selectGuessBefore(
+      candidates, history, m_leaders, deadline)};
+  m_leaders = selection.leaders;
+
+  // A cut-off scan may have missed the guess the strategy would pick
+  if (key.has_value() && selection.exact) {
+    table.store(key.value(), {selection.guess, selection.score});
+  }
+  return selection;
 }
 
 void StrategySelector::setStrategy(const StrategyType strategy) {
+  if (strategy != m_currentStrategy) {
+    m_leaders.clear(); // Leaders of one strategy mean little to another
+  }
   m_currentStrategy = strategy;
 }
 
@@ -40,37 +98,192 @@ std::string_view StrategySelector::getStrategyName(const StrategyType strategy)
     return "Frequency-based";
   case StrategyType::hybrid:
     return "Hybrid";
+  case StrategyType::optimal:
+    return "Optimal";
+  case StrategyType::worstCase:
+    return "Worst-case";
   default:
     return "Unknown";
   }
 }
 
+std::string_view StrategySelector::getStrategyKey(const StrategyType strategy) {
+  switch (strategy) {
+  case StrategyType::entropyBased:
+    return "entropy";
+  case StrategyType::miniMax:
+    return "minimax";
+  case StrategyType::frequencyBased:
+    return "frequency";
+  case StrategyType::hybrid:
+    return "hybrid";
+  case StrategyType::optimal:
+    return "optimal";
+  case StrategyType::worstCase:
+    return "worstcase";
+  default:
+    return "unknown";
+  }
+}
+
+std::optional<StrategySelector::StrategyType>
+StrategySelector::parseStrategyKey(const std::string_view key) {
+  for (uint32_t value{0};; ++value) {
+    const auto strategy{parseStrategy(value)};
+    if (!strategy.has_value() || getStrategyKey(strategy.value()) == key) {
+      return strategy;
+    }
+  }
+}
+
+std::optional<StrategySelector::StrategyType>
+StrategySelector::parseStrategy(const uint32_t value) {
+  switch (static_cast<StrategyType>(value)) {
+  case StrategyType::entropyBased:
+  case StrategyType::miniMax:
+  case StrategyType::frequencyBased:
+  case StrategyType::hybrid:
+  case StrategyType::optimal:
+  case StrategyType::worstCase:
+    return static_cast<StrategyType>(value);
+  default:
+    return std::nullopt;
+  }
+}
+
 void StrategySelector::clearCaches() {
-  m_entropyCache.clear();
-  m_minimaxCache.clear();
+  if (m_entropyCache) {
+    m_entropyCache->clear();
+  }
+  if (m_minimaxCache) {
+    m_minimaxCache->clear();
+  }
+}
+
+void StrategySelector::setWorkerCount(const size_t workerCount) {
+  m_workerCount = utils::resolveWorkerCount(workerCount);
+
+  // Strategies not created yet pick the count up when they are
+  for (IGuessStrategy* const strategy :
+       std::initializer_list<IGuessStrategy*>{
+           m_entropyStrategy.get(), m_minimaxStrategy.get(),
+           m_frequencyStrategy.get(), m_hybridStrategy.get(),
+           m_optimalStrategy.get(), m_worstCaseStrategy.get()}) {
+    if (strategy != nullptr) {
+      strategy->setWorkerCount(m_workerCount);
+    }
+  }
+}
+
+size_t StrategySelector::getWorkerCount() const { return m_workerCount; }
+
+void StrategySelector::addOpeningBook(
+    std::shared_ptr<const OpeningBook> book) {
+  if (!book) {
+    throw std::invalid_argument("Opening book must not be null");
+  }
+  m_openingBooks.push_back(std::move(book));
+}
+
+void StrategySelector::clearOpeningBooks() { m_openingBooks.clear(); }
+
+void StrategySelector::setEntropySampling(
+    const std::optional<EntropySampling>& sampling) {
+  m_entropySampling = sampling;
+  if (m_entropyStrategy) {
+    m_entropyStrategy->setSampling(sampling);
+  }
+}
+
+void StrategySelector::setTranspositions(const bool enabled) {
+  m_useTranspositions = enabled;
+}
+
+EntropyStrategy& StrategySelector::getEntropyStrategy() const {
+  if (!m_entropyStrategy) {
+    m_entropyCache = std::make_unique<CacheManager<double>>();
+    m_entropyStrategy = std::make_unique<EntropyStrategy>(*m_entropyCache);
+    m_entropyStrategy->setSampling(m_entropySampling);
+    m_entropyStrategy->setWorkerCount(m_workerCount);
+  }
+  return *m_entropyStrategy;
+}
+
+MinimaxStrategy& StrategySelector::getMinimaxStrategy() const {
+  if (!m_minimaxStrategy) {
+    m_minimaxCache = std::make_unique<CacheManager<size_t>>();
+    m_minimaxStrategy = std::make_unique<MinimaxStrategy>(*m_minimaxCache);
+    m_minimaxStrategy->setWorkerCount(m_workerCount);
+  }
+  return *m_minimaxStrategy;
+}
+
+FrequencyStrategy& StrategySelector::getFrequencyStrategy() const {
+  if (!m_frequencyStrategy) {
+    m_frequencyStrategy = std::make_unique<FrequencyStrategy>();
+    m_frequencyStrategy->setWorkerCount(m_workerCount);
+  }
+  return *m_frequencyStrategy;
 }
 
-void StrategySelector::initializeStrategies() {
-  // Create strategy instances with their dependencies
-  m_entropyStrategy = std::make_unique<EntropyStrategy>(m_entropyCache);
-  m_minimaxStrategy = std::make_unique<MinimaxStrategy>(m_minimaxCache);
-  m_frequencyStrategy = std::make_unique<FrequencyStrategy>();
+std::optional<int32_t>
+StrategySelector::lookupOpeningBooks(const GuessHistoryManager& history) const {
+  for (const auto& book : std::views::reverse(m_openingBooks)) {
+    if (book->getStrategy() != m_currentStrategy) {
+      continue;
+    }
+    if (const auto guess{book->lookup(history)}; guess.has_value()) {
+      return guess;
+    }
+  }
+  return std::nullopt;
+}
 
-  // Hybrid strategy depends on the other three strategies
-  m_hybridStrategy = std::make_unique<HybridStrategy>(
-      *m_entropyStrategy, *m_minimaxStrategy, *m_frequencyStrategy);
+uint64_t StrategySelector::getTranspositionSalt() const {
+  uint64_t salt{static_cast<uint64_t>(m_currentStrategy)};
+  if (m_entropySampling.has_value()) {
+    // FNV-1a over the settings that shape the race
+    const EntropySampling& sampling{m_entropySampling.value()};
+    for (const uint64_t field :
+         {uint64_t{1}, uint64_t{sampling.minCandidates},
+          uint64_t{sampling.initialSample}, uint64_t{sampling.finalists},
+          std::bit_cast<uint64_t>(sampling.confidence), sampling.seed}) {
+      salt = (salt ^ field) * 1099511628211ULL;
+    }
+  }
+  return salt;
 }
 
 const IGuessStrategy& StrategySelector::getCurrentStrategy() const {
   switch (m_currentStrategy) {
   case StrategyType::entropyBased:
-    return *m_entropyStrategy;
+    return getEntropyStrategy();
   case StrategyType::miniMax:
-    return *m_minimaxStrategy;
+    return getMinimaxStrategy();
   case StrategyType::frequencyBased:
-    return *m_frequencyStrategy;
+    return getFrequencyStrategy();
   case StrategyType::hybrid:
+    // Hybrid strategy depends on the other three strategies
+    if (!m_hybridStrategy) {
+      m_hybridStrategy = std::make_unique<HybridStrategy>(
+          getEntropyStrategy(), getMinimaxStrategy(), getFrequencyStrategy());
+      m_hybridStrategy->setWorkerCount(m_workerCount);
+    }
     return *m_hybridStrategy;
+  case StrategyType::optimal:
+    // The exact strategies memoize in the process-wide GameTreeSearch and
+    // WorstCaseSearch
+    if (!m_optimalStrategy) {
+      m_optimalStrategy = std::make_unique<OptimalStrategy>();
+      m_optimalStrategy->setWorkerCount(m_workerCount);
+    }
+    return *m_optimalStrategy;
+  case StrategyType::worstCase:
+    if (!m_worstCaseStrategy) {
+      m_worstCaseStrategy = std::make_unique<WorstCaseStrategy>();
+      m_worstCaseStrategy->setWorkerCount(m_workerCount);
+    }
+    return *m_worstCaseStrategy;
   default:
     throw std::runtime_error("Invalid strategy type");
   }
@@ -7,15 +7,22 @@
 
 #include "../interface/i_guess_strategy.hpp"
 #include "cache_manager.hpp"
+#include "candidate_view.hpp"
 #include "entropy_strategy.hpp"
 #include "frequency_strategy.hpp"
 #include "hybrid_strategy.hpp"
 #include "minimax_strategy.hpp"
+#include "optimal_strategy.hpp"
+#include "worst_case_strategy.hpp"
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string_view>
 #include <vector>
 
+class OpeningBook;
+
 /**
  * @class StrategySelector
  * @brief Factory and coordinator for guess selection strategies
@@ -41,7 +48,9 @@ public:
     entropyBased,   ///< Maximize information gain using entropy
     miniMax,        ///< Minimize worst-case remaining possibilities
     frequencyBased, ///< Use digit frequency analysis
-    hybrid          ///< Combine multiple strategies adaptively
+    hybrid,         ///< Combine multiple strategies adaptively
+    optimal,        ///< Minimize the expected number of guesses exactly
+    worstCase       ///< Minimize the worst-case number of guesses exactly
   };
 
   /**
@@ -51,15 +60,53 @@ public:
   explicit StrategySelector(
       StrategyType defaultStrategy = StrategyType::hybrid);
 
+  StrategySelector(const StrategySelector&) = delete;
+  StrategySelector& operator=(const StrategySelector&) = delete;
+
+  /**
+   * @brief Move constructor
+   *
+   * Strategies and the caches they reference live on the heap, so they move
+   * with the selector; the moved-from selector recreates its own on use.
+   */
+  StrategySelector(StrategySelector&& other) = default;
+
+  /**
+   * @brief Move assignment operator
+   * @return Reference to this selector
+   */
+  StrategySelector& operator=(StrategySelector&& other) = default;
+
+  ~StrategySelector() = default;
+
   /**
    * @brief Select the best guess using the current strategy
-   * @param possibleNumbers Vector of numbers still considered possible
+   * @param candidates View of the numbers still considered possible
    * @param history Reference to the guess history manager
    * @return The best guess according to the current strategy
+   *
+   * Opening books are consulted first, then the TranspositionTable, and only
+   * then is the strategy run.
    */
-  [[nodiscard]] int32_t selectGuess(const std::vector<int32_t>& possibleNumbers,
+  [[nodiscard]] int32_t selectGuess(const CandidateView& candidates,
                                     const GuessHistoryManager& history) const;
 
+  /**
+   * @brief Select a guess using the current strategy within a deadline
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager
+   * @param deadline No further guesses are scored once it has passed
+   * @return The best guess found and whether it is the guess selectGuess
+   * returns
+   *
+   * Guesses that led the previous selection are scored first, followed by the
+   * candidates, so a short deadline still weighs the likeliest good guesses.
+   */
+  [[nodiscard]] IGuessStrategy::Selection
+  selectGuessBefore(const CandidateView& candidates,
+                    const GuessHistoryManager& history,
+                    utils::Deadline deadline);
+
   /**
    * @brief Set the current strategy
    * @param strategy The strategy type to switch to
@@ -85,6 +132,29 @@ public:
    */
   [[nodiscard]] static std::string_view getStrategyName(StrategyType strategy);
 
+  /**
+   * @brief Get the short key of a strategy used in file names
+   * @param strategy The strategy type
+   * @return Lowercase key such as "hybrid"
+   */
+  [[nodiscard]] static std::string_view getStrategyKey(StrategyType strategy);
+
+  /**
+   * @brief Find the strategy with a short key
+   * @param key Lowercase key such as "hybrid", as given by getStrategyKey
+   * @return The strategy, or nullopt if the key is unknown
+   */
+  [[nodiscard]] static std::optional<StrategyType>
+  parseStrategyKey(std::string_view key);
+
+  /**
+   * @brief Convert a stored strategy value back to the enum
+   * @param value The stored value
+   * @return The strategy, or nullopt for values this build does not know
+   */
+  [[nodiscard]] static std::optional<StrategyType>
+  parseStrategy(uint32_t value);
+
   /**
    * @brief Clear all strategy caches
    *
@@ -93,30 +163,144 @@ public:
    */
   void clearCaches();
 
+  /**
+   * @brief Set the number of threads every strategy uses to score guesses
+   * @param workerCount Number of workers, 0 for one per hardware thread
+   *
+   * Selections are identical for every worker count.
+   */
+  void setWorkerCount(size_t workerCount);
+
+  /**
+   * @brief Get the number of threads used to score guesses
+   * @return Number of workers, at least 1
+   */
+  [[nodiscard]] size_t getWorkerCount() const;
+
+  /**
+   * @brief Register an opening book consulted before computing a guess
+   * @param book The book; it applies while its strategy is selected
+   *
+   * Books registered later take precedence for the same strategy.
+   */
+  void addOpeningBook(std::shared_ptr<const OpeningBook> book);
+
+  /**
+   * @brief Remove every registered opening book
+   */
+  void clearOpeningBooks();
+
+  /**
+   * @brief Enable or disable approximate entropy in large search spaces
+   * @param sampling Race settings, or nullopt to score every guess exactly
+   *
+   * Applies to the entropy strategy and to the early turns of the hybrid
+   * strategy; see EntropyStrategy::setSampling.
+   */
+  void setEntropySampling(const std::optional<EntropySampling>& sampling);
+
+  /**
+   * @brief Get the approximate entropy settings
+   * @return Race settings, or nullopt if every guess is scored exactly
+   */
+  [[nodiscard]] const std::optional<EntropySampling>&
+  getEntropySampling() const {
+    return m_entropySampling;
+  }
+
+  /**
+   * @brief Enable or disable the process-wide TranspositionTable
+   * @param enabled Whether selections are looked up in and stored to it
+   *
+   * Guesses are the same either way; the table only saves recomputing them.
+   * Enabled by default.
+   */
+  void setTranspositions(bool enabled);
+
+  /**
+   * @brief Check whether selections use the TranspositionTable
+   * @return true if enabled
+   */
+  [[nodiscard]] bool usesTranspositions() const { return m_useTranspositions; }
+
+  /**
+   * @brief Get the registered opening books
+   * @return Books in registration order
+   */
+  [[nodiscard]] std::span<const std::shared_ptr<const OpeningBook>>
+  getOpeningBooks() const {
+    return m_openingBooks;
+  }
+
 private:
   StrategyType m_currentStrategy; ///< Currently selected strategy type
+  size_t m_workerCount{1};        ///< Threads used by every strategy
+  bool m_useTranspositions{true}; ///< Whether TranspositionTable is used
+  std::optional<EntropySampling>
+      m_entropySampling; ///< Approximate entropy settings, if enabled
+  std::vector<std::shared_ptr<const OpeningBook>>
+      m_openingBooks; ///< Precomputed openings, newest last
+  std::vector<utils::Rank>
+      m_leaders; ///< Best guesses of the last timed selection, best first
 
-  // Cache managers for performance optimization
-  CacheManager<double> m_entropyCache; ///< Cache for entropy calculations
-  CacheManager<size_t> m_minimaxCache; ///< Cache for minimax calculations
+  // Cache managers for performance optimization, created with the strategy
+  // that uses them
+  mutable std::unique_ptr<CacheManager<double>>
+      m_entropyCache; ///< Cache for entropy calculations
+  mutable std::unique_ptr<CacheManager<size_t>>
+      m_minimaxCache; ///< Cache for minimax calculations
 
-  // Strategy instances
-  std::unique_ptr<EntropyStrategy>
+  // Strategy instances, created on first selection; a selector that only
+  // ever plays one strategy never allocates the others
+  mutable std::unique_ptr<EntropyStrategy>
       m_entropyStrategy; ///< Entropy-based strategy
-  std::unique_ptr<MinimaxStrategy> m_minimaxStrategy; ///< Minimax strategy
-  std::unique_ptr<FrequencyStrategy>
+  mutable std::unique_ptr<MinimaxStrategy>
+      m_minimaxStrategy; ///< Minimax strategy
+  mutable std::unique_ptr<FrequencyStrategy>
       m_frequencyStrategy; ///< Frequency-based strategy
-  std::unique_ptr<HybridStrategy> m_hybridStrategy; ///< Hybrid strategy
+  mutable std::unique_ptr<HybridStrategy>
+      m_hybridStrategy; ///< Hybrid strategy
+  mutable std::unique_ptr<OptimalStrategy>
+      m_optimalStrategy; ///< Exact expected-guess minimization
+  mutable std::unique_ptr<WorstCaseStrategy>
+      m_worstCaseStrategy; ///< Exact worst-case guess minimization
 
   /**
-   * @brief Initialize all strategy instances
-   *
-   * Creates and configures all strategy objects with their dependencies.
+   * @brief Get the entropy strategy, creating it on first use
+   * @return The strategy, configured with the current settings
+   */
+  [[nodiscard]] EntropyStrategy& getEntropyStrategy() const;
+
+  /**
+   * @brief Get the minimax strategy, creating it on first use
+   * @return The strategy, configured with the current settings
+   */
+  [[nodiscard]] MinimaxStrategy& getMinimaxStrategy() const;
+
+  /**
+   * @brief Get the frequency strategy, creating it on first use
+   * @return The strategy, configured with the current settings
+   */
+  [[nodiscard]] FrequencyStrategy& getFrequencyStrategy() const;
+
+  /**
+   * @brief Look up the current position in the opening books
+   * @param history The guesses made so far
+   * @return The newest book's guess for the current strategy, or nullopt if
+   * no book covers the position
+   */
+  [[nodiscard]] std::optional<int32_t>
+  lookupOpeningBooks(const GuessHistoryManager& history) const;
+
+  /**
+   * @brief Get the TranspositionTable salt of the current configuration
+   * @return Value that differs between configurations that may pick
+   * different guesses at the same position
    */
-  void initializeStrategies();
+  [[nodiscard]] uint64_t getTranspositionSalt() const;
 
   /**
-   * @brief Get the current strategy instance
+   * @brief Get the current strategy instance, creating it on first use
    * @return Reference to the currently selected strategy
    */
   [[nodiscard]] const IGuessStrategy& getCurrentStrategy() const;
@@ -0,0 +1,101 @@
+/**
+ * @file symmetry_reducer.cpp
+ * @brief Implementation of SymmetryReducer class
+ */
+
+#include "symmetry_reducer.hpp"
+#include "../utils/number_universe.hpp"
+#include "candidate_view.hpp"
+#include "guess_history_manager.hpp"
+#include <algorithm>
+#include <bitset>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Collect the digits of every guess in a history
+ * @param history The guesses made so far
+ * @return Bit d set when digit d appears in a guess
+ */
+uint32_t collectUsedDigits(const GuessHistoryManager& history) {
+  uint32_t usedDigits{0};
+  for (const int32_t guess : history.getGuesses()) {
+    // Feedback for a negative guess is undefined; treat every digit as used
+    usedDigits |=
+        guess >= 0 ? utils::digitMask(guess) : utils::Shape::allDigitsMask;
+  }
+  return usedDigits;
+}
+
+} // namespace
+
+SymmetryReducer::SymmetryReducer(const GuessHistoryManager& history)
+    : SymmetryReducer{collectUsedDigits(history)} {
+  std::erase_if(m_guessRanks, [&history](const utils::Rank rank) {
+    return history.hasBeenGuessed(utils::unrank(rank));
+  });
+}
+
+SymmetryReducer::SymmetryReducer(const uint32_t usedDigits)
+    : m_usedDigits{usedDigits} {
+  for (uint8_t digit{1}; digit < utils::alphabetSize; ++digit) {
+    if ((m_usedDigits & (1U << digit)) == 0) {
+      m_freeDigits[m_freeDigitCount++] = digit;
+    }
+  }
+
+  for (size_t rank{0}; rank < utils::validNumberCount; ++rank) {
+    if (isRepresentative(rank)) {
+      m_guessRanks.push_back(static_cast<utils::Rank>(rank));
+    }
+  }
+}
+
+std::vector<utils::Rank> SymmetryReducer::getGuessOrder(
+    const CandidateView& candidates,
+    const std::span<const utils::Rank> preferred) const {
+  std::vector<utils::Rank> order;
+  order.reserve(m_guessRanks.size());
+  std::bitset<utils::validNumberCount> placed;
+
+  for (const utils::Rank rank : preferred) {
+    if (!placed[rank] && std::ranges::binary_search(m_guessRanks, rank)) {
+      placed[rank] = true;
+      order.push_back(rank);
+    }
+  }
+  // A candidate may be the secret, so it can win outright
+  for (const utils::Rank rank : m_guessRanks) {
+    if (!placed[rank] && candidates.contains(rank)) {
+      placed[rank] = true;
+      order.push_back(rank);
+    }
+  }
+  for (const utils::Rank rank : m_guessRanks) {
+    if (!placed[rank]) {
+      order.push_back(rank);
+    }
+  }
+  return order;
+}
+
+bool SymmetryReducer::isRepresentative(const size_t rank) const {
+  if (isTrivial()) {
+    return true;
+  }
+
+  // Unused non-zero digits must be the smallest ones, in ascending order
+  const uint32_t packed{utils::packedDigits[rank]};
+  size_t nextFree{0};
+  for (int32_t pos{0}; pos < utils::numberSize; ++pos) {
+    const auto digit{static_cast<uint8_t>(utils::packedDigitAt(packed, pos))};
+    if (digit == 0 || (m_usedDigits & (1U << digit)) != 0) {
+      continue;
+    }
+    if (digit != m_freeDigits[nextFree++]) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file symmetry_reducer.hpp
+ * @brief Digit-permutation symmetry of candidate guesses
+ */
+
+#pragma once
+
+#include "../utils/number_universe.hpp"
+#include "../utils/utils.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class CandidateView;
+class GuessHistoryManager;
+
+/**
+ * @class SymmetryReducer
+ * @brief Picks one representative guess per class of equivalent guesses
+ *
+ * Relabeling digits that appear in no previous guess maps the numbers
+ * consistent with the history onto themselves, and a guess and its relabeling
+ * split those numbers into parts of identical sizes. Every score derived from
+ * the partition (or from per-position digit counts) is therefore equal within
+ * a class. Zero is kept out of the relabeling because it cannot lead a number.
+ *
+ * The representative is the smallest number of its class, so a scan that
+ * breaks ties by the lowest rank picks the same guess whether or not it skips
+ * the other members. This only holds when the candidates are exactly the
+ * numbers consistent with the history the reducer was built from.
+ *
+ * Representatives cluster at low ranks, so they are also collected into a
+ * dense list that can be sharded evenly across workers.
+ */
+class SymmetryReducer {
+public:
+  /**
+   * @brief Derive the interchangeable digits from a guess history
+   * @param history The guesses made so far
+   */
+  explicit SymmetryReducer(const GuessHistoryManager& history);
+
+  /**
+   * @brief Derive the interchangeable digits from the digits guessed so far
+   * @param usedDigits Bit d set when digit d appears in a previous guess
+   *
+   * Without a history, getGuessRanks() also lists representatives that were
+   * guessed already.
+   */
+  explicit SymmetryReducer(uint32_t usedDigits);
+
+  /**
+   * @brief Get the guesses that need scoring
+   * @return Ascending ranks of the representatives not guessed yet
+   */
+  [[nodiscard]] std::span<const utils::Rank> getGuessRanks() const {
+    return m_guessRanks;
+  }
+
+  /**
+   * @brief Order the guesses that need scoring by how promising they are
+   * @param candidates Numbers consistent with the history
+   * @param preferred Ranks of guesses to put first, in the given order
+   * @return The ranks of getGuessRanks(): preferred guesses first, then
+   * candidates, then the remaining guesses, each group ascending
+   *
+   * Preferred guesses that are not representatives or were guessed already
+   * are left out.
+   */
+  [[nodiscard]] std::vector<utils::Rank>
+  getGuessOrder(const CandidateView& candidates,
+                std::span<const utils::Rank> preferred) const;
+
+  /**
+   * @brief Check whether a guess is the representative of its class
+   * @param rank Rank of the guess
+   * @return true if the guess must be scored, false if an equivalent smaller
+   * guess is scored instead
+   */
+  [[nodiscard]] bool isRepresentative(size_t rank) const;
+
+  /**
+   * @brief Check whether the history leaves any symmetry to exploit
+   * @return true if at most one non-zero digit is unused
+   */
+  [[nodiscard]] bool isTrivial() const { return m_freeDigitCount <= 1; }
+
+  /**
+   * @brief Get the digits that are not interchangeable
+   * @return Bit d set when digit d appears in a previous guess
+   */
+  [[nodiscard]] uint32_t getUsedDigits() const { return m_usedDigits; }
+
+private:
+  uint32_t m_usedDigits{0}; ///< Bit d set when digit d appears in a guess
+  std::array<uint8_t, utils::alphabetSize - 1>
+      m_freeDigits{};         ///< Unused non-zero digits, ascending
+  size_t m_freeDigitCount{0}; ///< Entries of m_freeDigits in use
+  std::vector<utils::Rank>
+      m_guessRanks; ///< Representatives not guessed yet
+};
@@ -0,0 +1,56 @@
+/**
+ * @file tiled_scorer.cpp
+ * @brief Implementation of TiledScorer class
+ */
+
+#include "tiled_scorer.hpp"
+#include "../utils/feedback_kernel.hpp"
+#include "../utils/number_universe.hpp"
+#include "feedback_table.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+bool TiledScorer::isPreferred(const CandidateView& candidates) {
+  return !FeedbackTable::tabulated &&
+         candidates.size() <= Partition::slicedThreshold;
+}
+
+TiledScorer::TiledScorer(const CandidateView& candidates) {
+  m_digits.reserve(candidates.size());
+  m_masks.reserve(candidates.size());
+  candidates.forEach([this](const size_t rank) {
+    m_digits.push_back(utils::packedDigits[rank]);
+    m_masks.push_back(utils::digitMasks[rank]);
+  });
+}
+
+void TiledScorer::partition(const std::span<const utils::Rank> guessRanks,
+                            const std::span<Partition> partitions) const {
+  if (guessRanks.size() != partitions.size()) {
+    throw std::invalid_argument("Need one partition per guess");
+  }
+  if (guessRanks.size() > blockSize) {
+    throw std::invalid_argument("Too many guesses for one block");
+  }
+
+  std::array<Partition::CodeCounts, blockSize> counts{};
+  for (size_t begin{0}; begin < m_digits.size(); begin += tileSize) {
+    const size_t length{std::min(tileSize, m_digits.size() - begin)};
+    const std::span<const uint32_t> tileDigits{m_digits.data() + begin,
+                                               length};
+    const std::span<const uint32_t> tileMasks{m_masks.data() + begin, length};
+
+    // The tile stays cached while every guess of the block passes over it
+    for (size_t guess{0}; guess < guessRanks.size(); ++guess) {
+      const size_t rank{guessRanks[guess]};
+      utils::accumulateFeedbackHistogram(
+          {utils::packedDigits[rank], utils::digitMasks[rank]}, tileDigits,
+          tileMasks, counts[guess]);
+    }
+  }
+
+  for (size_t guess{0}; guess < guessRanks.size(); ++guess) {
+    partitions[guess] = Partition{counts[guess]};
+  }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file tiled_scorer.hpp
+ * @brief Cache-blocked partitioning of a search space by blocks of guesses
+ */
+
+#pragma once
+
+#include "../utils/parallel.hpp"
+#include "../utils/utils.hpp"
+#include "candidate_view.hpp"
+#include "partition.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * @class TiledScorer
+ * @brief Partitions the candidates of a position by many guesses at once
+ *
+ * Variants too large for a FeedbackTable score every guess against every
+ * candidate from the digits. Doing so one guess at a time streams the whole
+ * search space through the cache once per guess. The scorer instead copies
+ * the candidates' packed digits and digit masks into contiguous arrays once
+ * per position, and walks them in tiles small enough to stay in L2 while a
+ * block of guesses is scored against each tile with the batched feedback
+ * kernel. The histograms of a block stay in L1, and every candidate is read
+ * from memory once per block instead of once per guess.
+ *
+ * Dense sets, where the bit-sliced masks are cheaper than touching every
+ * candidate, are left to Partition.
+ */
+class TiledScorer {
+public:
+  static constexpr size_t tileSize{
+      8192}; ///< Candidates per tile (64 KiB of digits and masks)
+  static constexpr size_t blockSize{
+      utils::rankBlockSize}; ///< Guesses whose histograms are kept hot
+
+  /**
+   * @brief Check whether tiled scoring beats Partition for a search space
+   * @param candidates View of the numbers still considered possible
+   * @return true if the variant has no feedback table and the set is too
+   * sparse for the bit-sliced masks
+   */
+  [[nodiscard]] static bool isPreferred(const CandidateView& candidates);
+
+  /**
+   * @brief Pack the candidates of a position
+   * @param candidates View of the numbers still considered possible
+   */
+  explicit TiledScorer(const CandidateView& candidates);
+
+  /**
+   * @brief Partition the candidates by each of a block of guesses
+   * @param guessRanks Ranks of the guesses, at most blockSize of them
+   * @param partitions Output, one partition per guess
+   * @throws std::invalid_argument if the spans differ in length or the block
+   * is too large
+   */
+  void partition(std::span<const utils::Rank> guessRanks,
+                 std::span<Partition> partitions) const;
+
+  /**
+   * @brief Score the guesses of a block that have no score yet
+   * @tparam Score The score type
+   * @param guessRanks Ranks of the guesses, at most blockSize of them
+   * @param scores Scores by guess; those already set, such as cached ones,
+   * are left as they are
+   * @param score Callable taking (rank, partition) and returning the score
+   */
+  template <typename Score, typename ScoreFn>
+  void score(const std::span<const utils::Rank> guessRanks,
+             const std::span<std::optional<Score>> scores,
+             ScoreFn&& score) const {
+    std::array<utils::Rank, blockSize> pending{};
+    std::array<size_t, blockSize> slots{};
+    size_t pendingCount{0};
+    for (size_t i{0}; i < guessRanks.size() && i < scores.size(); ++i) {
+      if (!scores[i].has_value() && pendingCount < blockSize) {
+        pending[pendingCount] = guessRanks[i];
+        slots[pendingCount] = i;
+        ++pendingCount;
+      }
+    }
+
+    std::array<Partition, blockSize> partitions;
+    partition({pending.data(), pendingCount},
+              {partitions.data(), pendingCount});
+    for (size_t i{0}; i < pendingCount; ++i) {
+      scores[slots[i]] = std::invoke(score, size_t{pending[i]}, partitions[i]);
+    }
+  }
+
+  /**
+   * @brief Get the number of packed candidates
+   * @return Count of candidates
+   */
+  [[nodiscard]] size_t size() const { return m_digits.size(); }
+
+private:
+  std::vector<uint32_t> m_digits; ///< utils::packDigits of each candidate
+  std::vector<uint32_t> m_masks;  ///< utils::digitMask of each candidate
+};
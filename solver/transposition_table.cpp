@@ -0,0 +1,150 @@
+/**
+ * @file transposition_table.cpp
+ * @brief Implementation of TranspositionTable class
+ */
+
+#include "transposition_table.hpp"
+#include "guess_history_manager.hpp"
+#include <algorithm>
+#include <bit>
+#include <span>
+
+namespace {
+
+/**
+ * @brief Scramble a 64-bit value so that every input bit affects every
+ * output bit (the SplitMix64 finalizer)
+ * @param value The value to scramble
+ * @return The scrambled value
+ */
+constexpr uint64_t mix(uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+} // namespace
+
+TranspositionTable& TranspositionTable::getInstance() {
+  static TranspositionTable instance;
+  return instance;
+}
+
+TranspositionTable::TranspositionTable() { setCapacity(defaultCapacity); }
+
+uint64_t TranspositionTable::fingerprint(const NumberSet& candidates,
+                                         const GuessHistoryManager& history,
+                                         const uint64_t salt) {
+  uint64_t hash{mix(salt + 0x9E3779B97F4A7C15ULL)};
+  for (const NumberSet::Word word : candidates.words()) {
+    hash = mix(hash ^ word);
+  }
+
+  // The order of the guesses does not change the position, so they are
+  // combined with commutative operations rather than sorted
+  const std::vector<int32_t>& guesses{history.getGuesses()};
+  uint64_t guessSum{0};
+  uint64_t guessXor{0};
+  for (const int32_t guess : guesses) {
+    const uint64_t mixed{mix(static_cast<uint32_t>(guess))};
+    guessSum += mixed;
+    guessXor ^= mixed;
+  }
+  hash = mix(hash ^ guesses.size());
+  hash = mix(hash ^ guessSum);
+  hash = mix(hash ^ guessXor);
+
+  return hash == 0 ? 1 : hash; // 0 marks a free slot
+}
+
+std::optional<TranspositionTable::Entry>
+TranspositionTable::lookup(const uint64_t key) const {
+  Shard& shard{m_shards[key % shardCount]};
+  {
+    const std::scoped_lock lock{shard.mutex};
+    if (!shard.slots.empty()) {
+      const size_t bucketCount{shard.slots.size() / wayCount};
+      const size_t first{(key / shardCount) % bucketCount * wayCount};
+      for (size_t way{0}; way < wayCount; ++way) {
+        Slot& slot{shard.slots[first + way]};
+        if (slot.key != key) {
+          continue;
+        }
+        slot.lastUse = ++shard.clock;
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return Entry{slot.guess, slot.scored
+                                     ? std::optional<double>{slot.score}
+                                     : std::nullopt};
+      }
+    }
+  }
+  m_misses.fetch_add(1, std::memory_order_relaxed);
+  return std::nullopt;
+}
+
+void TranspositionTable::store(const uint64_t key, const Entry& entry) const {
+  Shard& shard{m_shards[key % shardCount]};
+  const std::scoped_lock lock{shard.mutex};
+  if (shard.slots.empty()) {
+    return;
+  }
+
+  const size_t bucketCount{shard.slots.size() / wayCount};
+  const size_t first{(key / shardCount) % bucketCount * wayCount};
+
+  // Reuse the position's own slot or a free one before evicting
+  const auto bucket{std::span{shard.slots}.subspan(first, wayCount)};
+  auto target{std::ranges::find(bucket, key, &Slot::key)};
+  if (target == bucket.end()) {
+    target = std::ranges::find(bucket, uint64_t{0}, &Slot::key);
+  }
+  if (target == bucket.end()) {
+    target = std::ranges::min_element(bucket, {}, &Slot::lastUse);
+    m_evictions.fetch_add(1, std::memory_order_relaxed);
+  } else if (target->key == 0) {
+    ++shard.used;
+  }
+
+  *target = Slot{key, entry.score.value_or(0.0), entry.guess, ++shard.clock,
+                 entry.score.has_value()};
+  m_stores.fetch_add(1, std::memory_order_relaxed);
+}
+
+TranspositionTable::Stats TranspositionTable::getStats() const {
+  Stats stats{m_hits.load(std::memory_order_relaxed),
+              m_misses.load(std::memory_order_relaxed),
+              m_stores.load(std::memory_order_relaxed),
+              m_evictions.load(std::memory_order_relaxed)};
+  for (Shard& shard : m_shards) {
+    const std::scoped_lock lock{shard.mutex};
+    stats.size += shard.used;
+    stats.capacity += shard.slots.size();
+  }
+  return stats;
+}
+
+void TranspositionTable::setCapacity(const size_t capacity) {
+  const size_t perShard{(capacity + shardCount - 1) / shardCount};
+  const size_t bucketCount{
+      capacity == 0 ? 0 : std::bit_ceil((perShard + wayCount - 1) / wayCount)};
+
+  for (Shard& shard : m_shards) {
+    const std::scoped_lock lock{shard.mutex};
+    shard.slots.assign(bucketCount * wayCount, Slot{});
+    shard.used = 0;
+    shard.clock = 0;
+  }
+}
+
+void TranspositionTable::clear() {
+  for (Shard& shard : m_shards) {
+    const std::scoped_lock lock{shard.mutex};
+    std::ranges::fill(shard.slots, Slot{});
+    shard.used = 0;
+    shard.clock = 0;
+  }
+  m_hits = 0;
+  m_misses = 0;
+  m_stores = 0;
+  m_evictions = 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file transposition_table.hpp
+ * @brief Process-wide table of guesses already selected for a search space
+ */
+
+#pragma once
+
+#include "number_set.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+class GuessHistoryManager;
+
+/**
+ * @class TranspositionTable
+ * @brief Bounded hash table from positions to the guesses selected there
+ *
+ * Every game played with the same strategy passes through the same early
+ * positions, and a strategy always picks the same guess at the same position.
+ * The table remembers those picks under a 64-bit fingerprint of the position,
+ * so a position that any solver in the process has seen before costs a
+ * lookup instead of a scan.
+ *
+ * A position is the candidate bitset together with the guesses made so far,
+ * since those decide which guesses are scored and how ties are broken. Two
+ * different positions sharing a fingerprint are not told apart; with 64-bit
+ * fingerprints this is vanishingly unlikely.
+ *
+ * The table is split into lock-protected shards of 4-way buckets. A full
+ * bucket replaces its least recently used entry, so memory stays fixed while
+ * the positions in current use stay cached.
+ */
+class TranspositionTable {
+public:
+  static constexpr size_t defaultCapacity{
+      size_t{1} << 16}; ///< Entries until setCapacity() is called
+
+  /**
+   * @struct Entry
+   * @brief Guess remembered for a position
+   */
+  struct Entry {
+    int32_t guess;               ///< Guess the strategy selected
+    std::optional<double> score; ///< Its score, if the strategy scores guesses
+  };
+
+  /**
+   * @struct Stats
+   * @brief Usage counters since the table was last cleared
+   */
+  struct Stats {
+    uint64_t hits{0};      ///< Lookups that found their position
+    uint64_t misses{0};    ///< Lookups that did not
+    uint64_t stores{0};    ///< Positions stored
+    uint64_t evictions{0}; ///< Entries replaced to make room
+    size_t size{0};        ///< Entries in use
+    size_t capacity{0};    ///< Entries available
+  };
+
+  /**
+   * @brief Get the process-wide table
+   * @return Reference to the shared table
+   */
+  [[nodiscard]] static TranspositionTable& getInstance();
+
+  TranspositionTable(const TranspositionTable&) = delete;
+  TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+  /**
+   * @brief Fingerprint a position
+   * @param candidates Numbers consistent with history
+   * @param history The guesses made so far
+   * @param salt Distinguishes tables of different strategies
+   * @return Non-zero 64-bit fingerprint
+   */
+  [[nodiscard]] static uint64_t fingerprint(const NumberSet& candidates,
+                                            const GuessHistoryManager& history,
+                                            uint64_t salt);
+
+  /**
+   * @brief Look up the guess remembered for a position
+   * @param key Fingerprint of the position
+   * @return The entry, or nullopt if the position is not in the table
+   */
+  [[nodiscard]] std::optional<Entry> lookup(uint64_t key) const;
+
+  /**
+   * @brief Remember the guess selected at a position
+   * @param key Fingerprint of the position
+   * @param entry The guess and its score
+   */
+  void store(uint64_t key, const Entry& entry) const;
+
+  /**
+   * @brief Get the usage counters
+   * @return Counters since the last clear()
+   */
+  [[nodiscard]] Stats getStats() const;
+
+  /**
+   * @brief Resize the table, dropping every entry
+   * @param capacity Entries to make room for, rounded up to fill whole
+   * buckets in every shard; 0 disables the table
+   */
+  void setCapacity(size_t capacity);
+
+  /**
+   * @brief Drop every entry and reset the counters
+   */
+  void clear();
+
+private:
+  /**
+   * @brief Private constructor that allocates defaultCapacity entries
+   */
+  TranspositionTable();
+
+  /**
+   * @struct Slot
+   * @brief One stored position
+   */
+  struct Slot {
+    uint64_t key{0};     ///< Fingerprint, 0 when the slot is free
+    double score{0.0};   ///< Score of guess, if scored
+    int32_t guess{0};    ///< Remembered guess
+    uint32_t lastUse{0}; ///< Shard clock at the last store or hit
+    bool scored{false};  ///< Whether score is set
+  };
+
+  /**
+   * @struct Shard
+   * @brief One lock-protected slice of the table
+   */
+  struct Shard {
+    std::mutex mutex;        ///< Guards the fields below
+    std::vector<Slot> slots; ///< Buckets of wayCount consecutive slots
+    size_t used{0};          ///< Slots holding a position
+    uint32_t clock{0};       ///< Advances on every store or hit
+  };
+
+  static constexpr size_t shardCount{64}; ///< Table slices
+  static constexpr size_t wayCount{4};    ///< Slots per bucket
+
+  mutable std::array<Shard, shardCount> m_shards; ///< Table, sliced by key
+  mutable std::atomic<uint64_t> m_hits{0};        ///< Lookups that hit
+  mutable std::atomic<uint64_t> m_misses{0};      ///< Lookups that missed
+  mutable std::atomic<uint64_t> m_stores{0};      ///< Positions stored
+  mutable std::atomic<uint64_t> m_evictions{0};   ///< Entries replaced
+};
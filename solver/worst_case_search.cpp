@@ -0,0 +1,302 @@
+/**
+ * @file worst_case_search.cpp
+ * @brief Implementation of WorstCaseSearch class
+ */
+
+#include "worst_case_search.hpp"
+#include "../utils/number_universe.hpp"
+#include "../utils/parallel.hpp"
+#include "feedback_table.hpp"
+#include "guess_history_manager.hpp"
+#include "symmetry_reducer.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+constexpr uint8_t winCode{
+    utils::encodeFeedback(utils::numberSize, 0)}; ///< Code of a correct guess
+
+constexpr uint32_t maxDepth{
+    utils::validNumberCount}; ///< Guessing candidates in turn never needs more
+
+using CodeCounts =
+    std::array<uint32_t, utils::feedbackCodeCount>; ///< Part size by code
+
+constexpr size_t branching{utils::feedbackBucketCount -
+                           1}; ///< Parts left by a guess that does not win
+
+/**
+ * @brief Count the depths up to the first one that may cover every number
+ * @return Number of entries of the capacity table
+ */
+consteval size_t countCapacityDepths() {
+  size_t capacity{0};
+  size_t depths{1};
+  for (; capacity < utils::validNumberCount; ++depths) {
+    capacity = 1 + branching * capacity;
+  }
+  return depths;
+}
+
+constexpr size_t capacityDepths{
+    countCapacityDepths()}; ///< Entries of the capacity table
+
+/**
+ * @brief Tabulate how many candidates each depth can tell apart
+ * @return Largest set size that may fit in each depth, up to the first depth
+ * that covers every number
+ */
+consteval std::array<size_t, capacityDepths> generateCapacities() {
+  // A guess finds at most itself and leaves at most one part per non-winning
+  // feedback, each of which gets one guess less
+  std::array<size_t, capacityDepths> capacities{};
+  for (size_t depth{1}; depth < capacities.size(); ++depth) {
+    capacities[depth] = std::min<size_t>(
+        1 + branching * capacities[depth - 1], utils::validNumberCount);
+  }
+  return capacities;
+}
+
+constexpr std::array<size_t, capacityDepths> capacities{
+    generateCapacities()}; ///< Largest set that may fit, by depth
+
+static_assert(capacities.back() == utils::validNumberCount,
+              "capacities must cover every number");
+
+/**
+ * @brief Get the largest set that may fit in a depth
+ * @param depth Guesses available
+ * @return Upper bound on the size of a set of that depth
+ */
+size_t capacity(const uint32_t depth) {
+  return depth < capacities.size() ? capacities[depth]
+                                   : utils::validNumberCount;
+}
+
+} // namespace
+
+WorstCaseSearch& WorstCaseSearch::getInstance() {
+  static WorstCaseSearch instance{};
+  return instance;
+}
+
+WorstCaseSearch::WorstCaseSearch() = default;
+
+std::optional<WorstCaseSearch::Decision>
+WorstCaseSearch::solve(const CandidateView& candidates,
+                       const GuessHistoryManager& history,
+                       const size_t workerCount,
+                       const std::stop_token& stop) const {
+  if constexpr (!FeedbackTable::tabulated) {
+    throw std::runtime_error("Exhaustive search needs a feedback table, "
+                             "which this variant is too large for");
+  }
+
+  if (candidates.empty()) {
+    return std::nullopt;
+  }
+
+  std::vector<utils::Rank> set;
+  set.reserve(candidates.size());
+  candidates.forEach([&set](const size_t rank) {
+    set.push_back(static_cast<utils::Rank>(rank));
+  });
+
+  // Guessing the smaller of two candidates is as good as it gets
+  if (set.size() <= 2) {
+    return Decision{utils::unrank(set.front()),
+                    static_cast<uint32_t>(set.size())};
+  }
+
+  const SymmetryReducer symmetry{history};
+  const uint32_t usedDigits{symmetry.getUsedDigits()};
+  std::vector<utils::Rank> key{SetMemo::canonicalize(set)};
+  uint32_t depth{lowerBound(set.size())};
+  if (const auto known{m_memo.lookup(key)}; known.has_value()) {
+    depth = std::max(depth, static_cast<uint32_t>(known->cost));
+  }
+
+  // Deepen until some guess fits; the workers share the guesses of each depth
+  // and skip those after the first guess found to fit, which is the one kept
+  for (; depth <= maxDepth; ++depth) {
+    const auto guesses{orderGuesses(set, symmetry.getGuessRanks(), depth)};
+    std::atomic<size_t> firstFit{std::numeric_limits<size_t>::max()};
+
+    std::optional<utils::ArgBest<size_t>> best;
+    try {
+      best = utils::parallelArgBest(
+          guesses.size(), workerCount,
+          [&](size_t, const size_t index) -> std::optional<size_t> {
+            if (stop.stop_requested()) {
+              throw Stopped{};
+            }
+            if (index > firstFit.load(std::memory_order_relaxed) ||
+                !guessFits(set, guesses[index], usedDigits, depth, stop)) {
+              return std::nullopt;
+            }
+            size_t current{firstFit.load(std::memory_order_relaxed)};
+            while (index < current && !firstFit.compare_exchange_weak(
+                                          current, index,
+                                          std::memory_order_relaxed)) {
+            }
+            return index;
+          },
+          std::less{});
+    } catch (const Stopped&) {
+      return std::nullopt;
+    }
+
+    if (best.has_value()) {
+      m_memo.store(std::move(key), {depth, true});
+      return Decision{utils::unrank(guesses[best->index]), depth};
+    }
+    m_memo.store(key, {depth + 1, false});
+  }
+
+  return Decision{candidates.front(), maxDepth};
+}
+
+size_t WorstCaseSearch::getMemoSize() const { return m_memo.size(); }
+
+void WorstCaseSearch::clear() { m_memo.clear(); }
+
+uint32_t WorstCaseSearch::lowerBound(const size_t size) {
+  uint32_t depth{0};
+  while (capacity(depth) < size) {
+    ++depth;
+  }
+  return depth;
+}
+
+bool WorstCaseSearch::fits(const std::span<const utils::Rank> set,
+                           const uint32_t usedDigits, const uint32_t depth,
+                           const std::stop_token& stop) const {
+  // One or two candidates are found by guessing them in turn
+  if (set.size() <= 2) {
+    return set.size() <= depth;
+  }
+  uint32_t bound{lowerBound(set.size())};
+  if (bound > depth) {
+    return false;
+  }
+
+  std::vector<utils::Rank> key{SetMemo::canonicalize(set)};
+  if (const auto known{m_memo.lookup(key)}; known.has_value()) {
+    if (known->exact || known->cost > depth) {
+      return known->cost <= depth;
+    }
+    bound = std::max(bound, static_cast<uint32_t>(known->cost));
+  }
+
+  const SymmetryReducer symmetry{usedDigits};
+  for (const utils::Rank rank : orderGuesses(set, symmetry.getGuessRanks(),
+                                          depth)) {
+    if (stop.stop_requested()) {
+      throw Stopped{};
+    }
+    if (guessFits(set, rank, usedDigits, depth, stop)) {
+      // The depth is exact once every smaller depth has been ruled out
+      if (bound == depth) {
+        m_memo.store(std::move(key), {depth, true});
+      }
+      return true;
+    }
+  }
+
+  m_memo.store(std::move(key), {depth + 1, false});
+  return false;
+}
+
+bool WorstCaseSearch::guessFits(const std::span<const utils::Rank> set,
+                                const size_t guessRank,
+                                const uint32_t usedDigits,
+                                const uint32_t depth,
+                                const std::stop_token& stop) const {
+  const auto codes{FeedbackTable::getInstance().row(guessRank)};
+  CodeCounts counts{};
+  for (const utils::Rank target : set) {
+    ++counts[codes[target]];
+  }
+
+  // Split the candidates into contiguous, still ascending parts
+  std::array<uint32_t, utils::feedbackCodeCount + 1> offsets{};
+  for (size_t code{0}; code < utils::feedbackCodeCount; ++code) {
+    offsets[code + 1] = offsets[code] + counts[code];
+  }
+  std::vector<utils::Rank> parts(set.size());
+  std::array<uint32_t, utils::feedbackCodeCount> next{};
+  std::copy_n(offsets.begin(), utils::feedbackCodeCount, next.begin());
+  for (const utils::Rank target : set) {
+    parts[next[codes[target]]++] = target;
+  }
+
+  // Search large parts first; they are the most likely not to fit
+  std::array<uint8_t, utils::feedbackBucketCount> order{};
+  size_t orderCount{0};
+  for (size_t code{0}; code < utils::feedbackCodeCount; ++code) {
+    if (code != winCode && counts[code] > 0) {
+      order[orderCount++] = static_cast<uint8_t>(code);
+    }
+  }
+  std::sort(order.begin(), order.begin() + orderCount,
+            [&counts](const uint8_t lhs, const uint8_t rhs) {
+              return counts[lhs] > counts[rhs];
+            });
+
+  const uint32_t nextUsedDigits{usedDigits | utils::digitMasks[guessRank]};
+  return std::all_of(
+      order.begin(), order.begin() + orderCount, [&](const uint8_t code) {
+        const std::span<const utils::Rank> part{parts.data() + offsets[code],
+                                                counts[code]};
+        return fits(part, nextUsedDigits, depth - 1, stop);
+      });
+}
+
+std::vector<utils::Rank>
+WorstCaseSearch::orderGuesses(const std::span<const utils::Rank> set,
+                              const std::span<const utils::Rank> guessRanks,
+                              const uint32_t depth) {
+  const FeedbackTable& table{FeedbackTable::getInstance()};
+  const size_t partCapacity{depth == 0 ? 0 : capacity(depth - 1)};
+
+  // Read the codes of ascending guesses as one stream per candidate row, as
+  // GameTreeSearch does; feedback is symmetric in guess and target
+  std::vector<const uint8_t*> rows;
+  rows.reserve(set.size());
+  for (const utils::Rank target : set) {
+    rows.push_back(table.row(target).data());
+  }
+
+  std::vector<std::pair<uint64_t, utils::Rank>> ordered;
+  for (const utils::Rank rank : guessRanks) {
+    CodeCounts counts{};
+    for (const uint8_t* const row : rows) {
+      ++counts[row[rank]];
+    }
+
+    uint32_t largest{0};
+    for (size_t code{0}; code < utils::feedbackCodeCount; ++code) {
+      largest = code == winCode ? largest : std::max(largest, counts[code]);
+    }
+    // A guess that leaves every candidate in one part only wastes a turn
+    if (largest > partCapacity || largest == set.size()) {
+      continue;
+    }
+    ordered.emplace_back(uint64_t{largest} * 2 + (counts[winCode] == 0 ? 1 : 0),
+                         rank);
+  }
+
+  std::ranges::sort(ordered);
+  std::vector<utils::Rank> guesses;
+  guesses.reserve(ordered.size());
+  for (const auto& [key, rank] : ordered) {
+    guesses.push_back(rank);
+  }
+  return guesses;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file worst_case_search.hpp
+ * @brief Depth-limited search for the policy with the fewest guesses in the
+ * worst case
+ */
+
+#pragma once
+
+#include "candidate_view.hpp"
+#include "set_memo.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <vector>
+
+class GuessHistoryManager;
+
+/**
+ * @class WorstCaseSearch
+ * @brief Iterative deepening over feedback partitions
+ *
+ * The depth of a set of candidates is the number of guesses, counting the
+ * final correct one, that an optimal policy needs to find any of them. A set
+ * fits in a depth when some guess splits it into parts that each fit in one
+ * guess less, so depths are tried from a lower bound upwards until a guess is
+ * found; the first depth that fits is the depth of the set, and playing the
+ * guess that proves it keeps every later position within the depth.
+ *
+ * A guess is only tried when none of its parts holds more candidates than the
+ * remaining guesses can tell apart, and guesses with smaller largest parts are
+ * tried first. Depths that are proven, and depths a set is proven not to fit
+ * in, are memoized by canonical candidate set (see SetMemo) in one memo shared
+ * by every solver in the process.
+ *
+ * As in GameTreeSearch, one guess per class of digit relabelings is tried, so
+ * the candidates must be exactly the numbers consistent with the history.
+ */
+class WorstCaseSearch {
+public:
+  /**
+   * @struct Decision
+   * @brief Guess that proves the depth of a position
+   */
+  struct Decision {
+    int32_t guess;  ///< Guess to make
+    uint32_t depth; ///< Guesses that find any candidate, this one included
+  };
+
+  /**
+   * @brief Get the process-wide search and its memo
+   * @return Reference to the shared search
+   */
+  [[nodiscard]] static WorstCaseSearch& getInstance();
+
+  WorstCaseSearch(const WorstCaseSearch&) = delete;
+  WorstCaseSearch& operator=(const WorstCaseSearch&) = delete;
+
+  /**
+   * @brief Find a guess that finds any candidate in the fewest guesses
+   * @param candidates Numbers consistent with history
+   * @param history The guesses made so far
+   * @param workerCount Threads sharing the guesses of the position
+   * @param stop Abandons the search between two guesses once requested
+   * @return The first guess in search order that reaches the depth of the
+   * position, or nullopt if there are no candidates or the search was stopped
+   *
+   * @throws std::runtime_error if the variant has no feedback table
+   *
+   * The decision does not depend on workerCount. A stopped search memoizes
+   * only the sets it finished.
+   */
+  [[nodiscard]] std::optional<Decision>
+  solve(const CandidateView& candidates, const GuessHistoryManager& history,
+        size_t workerCount, const std::stop_token& stop = {}) const;
+
+  /**
+   * @brief Get the number of memoized sets
+   * @return Entries in the memo
+   */
+  [[nodiscard]] size_t getMemoSize() const;
+
+  /**
+   * @brief Forget every memoized set
+   */
+  void clear();
+
+  /**
+   * @brief Lower bound on the depth of any set of a given size
+   * @param size Number of candidates
+   * @return Fewest guesses if each guess could split the candidates into
+   * utils::feedbackBucketCount - 1 parts plus the guess itself
+   */
+  [[nodiscard]] static uint32_t lowerBound(size_t size);
+
+private:
+  /**
+   * @struct Stopped
+   * @brief Unwinds a search whose stop was requested, past every memo store
+   */
+  struct Stopped {};
+
+  /**
+   * @brief Private constructor that creates an empty memo
+   */
+  WorstCaseSearch();
+
+  /**
+   * @brief Check whether any candidate of a set is found within a depth
+   * @param set Ascending ranks of the candidates
+   * @param usedDigits Bit d set when digit d appears in a guess so far
+   * @param depth Guesses available
+   * @param stop Abandons the search once requested
+   * @return true if some policy finds every candidate within depth guesses
+   * @throws Stopped once a stop is requested
+   */
+  [[nodiscard]] bool fits(std::span<const utils::Rank> set, uint32_t usedDigits,
+                          uint32_t depth, const std::stop_token& stop) const;
+
+  /**
+   * @brief Check whether a guess finds any candidate of a set within a depth
+   * @param set Ascending ranks of the candidates
+   * @param guessRank Rank of the guess
+   * @param usedDigits Bit d set when digit d appears in a guess so far
+   * @param depth Guesses available, this one included
+   * @param stop Abandons the search once requested
+   * @return true if every part of the guess fits in depth - 1 guesses
+   * @throws Stopped once a stop is requested
+   */
+  [[nodiscard]] bool guessFits(std::span<const utils::Rank> set,
+                               size_t guessRank, uint32_t usedDigits,
+                               uint32_t depth,
+                               const std::stop_token& stop) const;
+
+  /**
+   * @brief Keep the guesses whose parts are small enough and order them
+   * @param set Ascending ranks of the candidates
+   * @param guessRanks Guesses to consider
+   * @param depth Guesses available, the ordered guess included
+   * @return Ranks of the guesses whose largest part fits in depth - 1 guesses
+   * by size, smallest largest part first and candidates before other guesses
+   */
+  [[nodiscard]] static std::vector<utils::Rank>
+  orderGuesses(std::span<const utils::Rank> set,
+               std::span<const utils::Rank> guessRanks, uint32_t depth);
+
+  SetMemo m_memo; ///< Depths by canonical set
+};
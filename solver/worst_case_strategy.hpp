@@ -0,0 +1,61 @@
+/**
+ * @file worst_case_strategy.hpp
+ * @brief Guess selection that minimizes the worst-case number of guesses
+ */
+
+#pragma once
+
+#include "../interface/i_guess_strategy.hpp"
+#include "candidate_view.hpp"
+#include "guess_history_manager.hpp"
+#include <cstdint>
+
+/**
+ * @class WorstCaseStrategy
+ * @brief Guess selection with a proven bound on the length of the game
+ *
+ * MinimaxStrategy keeps the largest next partition small one guess ahead,
+ * which does not bound the length of the game. This strategy instead picks a
+ * guess that provably finds the secret in the fewest guesses in the worst
+ * case, searching deeper until such a guess is found. Every later position is
+ * within the bound proven before it, so the game never takes longer than the
+ * first bound: 7 guesses for the standard game.
+ *
+ * Proving the bound of a large position takes long; results are memoized by
+ * WorstCaseSearch for the whole process, and the opening is best precomputed
+ * into an opening book.
+ */
+class WorstCaseStrategy final : public IGuessStrategy {
+public:
+  /**
+   * @brief Select a guess that minimizes the worst-case number of guesses
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager
+   * @return A worst-case optimal guess
+   */
+  [[nodiscard]] int32_t
+  selectBestGuess(const CandidateView& candidates,
+                  const GuessHistoryManager& history) const override;
+
+  /**
+   * @brief Select the guess of selectBestGuess unless a stop is requested
+   * @param candidates View of the numbers still considered possible
+   * @param history Reference to the guess history manager
+   * @param preferred Unused; the search orders guesses itself
+   * @param deadline Its stop request abandons the search; its time does not,
+   * since a search cut short has no best guess so far
+   * @return The guess of selectBestGuess, or an inexact selection of the
+   * first candidate if the search was stopped
+   */
+  [[nodiscard]] Selection
+  selectGuessBefore(const CandidateView& candidates,
+                    const GuessHistoryManager& history,
+                    std::span<const utils::Rank> preferred,
+                    utils::Deadline deadline) const override;
+
+  /**
+   * @brief Get the name of this strategy
+   * @return String identifier for this strategy
+   */
+  [[nodiscard]] std::string_view getStrategyName() const override;
+};
@@ -0,0 +1,526 @@
+/**
+ * @file benchmark.cpp
+ * @brief Microbenchmarks of the solver hot paths
+ *
+ * Usage: 1a2b_bench [--filter TEXT] [--min-time SECONDS] [--repetitions N]
+ *                   [--threads N] [--json FILE|-]
+ *                   [--compare BASELINE] [--threshold PERCENT]
+ *
+ * Every kernel is timed in several repetitions and reported as the median
+ * time per operation. --json writes the results in the format --compare
+ * reads, so a run saved before an optimization is the baseline for the runs
+ * after it; --compare exits with status 1 if any kernel is slower than its
+ * baseline by more than the threshold (10% by default).
+ */
+
+#include "../solver/guess_history_manager.hpp"
+#include "../solver/search_space_manager.hpp"
+#include "../solver/strategy_selector.hpp"
+#include "../solver/transposition_table.hpp"
+#include "../utils/number_universe.hpp"
+#include "../utils/parallel.hpp"
+#include "../utils/utils.hpp"
+#include "simulation.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @struct BenchmarkOptions
+ * @brief How long and on how many threads to measure
+ */
+struct BenchmarkOptions {
+  std::string filter;     ///< Only run kernels whose name contains this
+  double minSeconds{0.5}; ///< Measuring time per kernel
+  size_t repetitions{5};  ///< Samples per kernel; the median is reported
+  size_t threadCount{1};  ///< Threads used to score guesses, 0 for all
+};
+
+/**
+ * @struct BenchmarkResult
+ * @brief Timing of one kernel
+ */
+struct BenchmarkResult {
+  std::string name;       ///< Kernel name, stable across runs
+  size_t iterations{0};   ///< Operations timed over all repetitions
+  double nsPerOp{0.0};    ///< Median time per operation
+  double minNsPerOp{0.0}; ///< Fastest repetition
+};
+
+/**
+ * @struct Position
+ * @brief A game position with a given number of candidates
+ */
+struct Position {
+  GuessHistoryManager history;    ///< Guesses leading to the position
+  SearchSpaceManager searchSpace; ///< Candidates at the position
+};
+
+constexpr std::array<std::pair<StrategySelector::StrategyType,
+                               std::string_view>,
+                     4>
+    selectorStrategies{{
+        {StrategySelector::StrategyType::entropyBased, "entropy"},
+        {StrategySelector::StrategyType::miniMax, "minimax"},
+        {StrategySelector::StrategyType::frequencyBased, "frequency"},
+        {StrategySelector::StrategyType::hybrid, "hybrid"},
+    }}; ///< Strategies benchmarked through StrategySelector
+
+constexpr std::array<size_t, 4> positionSizes{
+    static_cast<size_t>(utils::validNumberCount), 720, 100,
+    10}; ///< Candidate counts of the benchmarked positions, largest first
+
+volatile int64_t sink{0}; ///< Keeps benchmarked results observable
+
+/**
+ * @brief Pick a valid number at a fixed fraction of the universe
+ * @param eighths Position in the ascending valid numbers, in eighths
+ * @return The number, valid in every variant
+ */
+constexpr int32_t numberAt(const size_t eighths) {
+  return utils::validNumbers[utils::validNumbers.size() * eighths / 8];
+}
+
+/**
+ * @brief Run a batch of operations and return its duration
+ * @param op Operation taking the iteration index
+ * @param first Index of the first operation
+ * @param count Number of operations
+ * @return Elapsed nanoseconds
+ */
+template <typename Op>
+double runBatch(Op& op, const size_t first, const size_t count) {
+  int64_t total{0};
+  const auto start{Clock::now()};
+  for (size_t i{first}; i < first + count; ++i) {
+    total += static_cast<int64_t>(op(i));
+  }
+  const std::chrono::duration<double, std::nano> elapsed{Clock::now() -
+                                                         start};
+  sink = sink + total;
+  return elapsed.count();
+}
+
+/**
+ * @brief Time an operation
+ * @param name Kernel name
+ * @param options Measuring time and repetitions
+ * @param op Operation taking the iteration index and returning a value that
+ * depends on its work
+ * @return Median and fastest time per operation
+ */
+template <typename Op>
+BenchmarkResult measure(std::string name, const BenchmarkOptions& options,
+                        Op op) {
+  const double sampleNs{options.minSeconds * 1e9 /
+                        static_cast<double>(options.repetitions)};
+
+  // Grow the batch until the clock overhead is negligible
+  size_t batch{1};
+  while (batch < (size_t{1} << 30) &&
+         runBatch(op, 0, batch) < sampleNs / 20.0) {
+    batch *= 2;
+  }
+
+  BenchmarkResult result{std::move(name), 0, 0.0, 0.0};
+  std::vector<double> samples;
+  for (size_t repetition{0}; repetition < options.repetitions; ++repetition) {
+    double elapsedNs{0.0};
+    size_t count{0};
+    while (elapsedNs < sampleNs) {
+      elapsedNs += runBatch(op, result.iterations + count, batch);
+      count += batch;
+    }
+    samples.push_back(elapsedNs / static_cast<double>(count));
+    result.iterations += count;
+  }
+
+  std::ranges::sort(samples);
+  result.nsPerOp = samples[samples.size() / 2];
+  result.minNsPerOp = samples.front();
+  return result;
+}
+
+/**
+ * @brief Build a position with exactly the requested number of candidates
+ * @param size Candidate count
+ * @return A position reached by real feedback, trimmed to size
+ *
+ * Guesses are played against a fixed secret while the candidates stay above
+ * size, then the largest candidates are removed, so every run benchmarks the
+ * same position. Secret and guesses are taken from the valid numbers of the
+ * variant being built.
+ */
+Position makePosition(const size_t size) {
+  const int32_t secret{numberAt(4)};
+  const std::array<int32_t, 4> guesses{numberAt(1), numberAt(3), numberAt(5),
+                                       numberAt(7)};
+
+  Position position;
+  for (const int32_t guess : guesses) {
+    const auto [aCount, bCount]{utils::calculateAB(guess, secret)};
+    SearchSpaceManager next{position.searchSpace};
+    next.applyConstraint(guess, aCount, bCount);
+    if (next.getRemainingCount() < size) {
+      break;
+    }
+    position.history.addGuess(guess, aCount, bCount);
+    position.searchSpace = std::move(next);
+  }
+
+  while (position.searchSpace.getRemainingCount() > size) {
+    position.searchSpace.eliminateNumber(
+        position.searchSpace.getPossibleNumbers().back());
+  }
+  return position;
+}
+
+/**
+ * @brief Run every kernel whose name matches the filter
+ * @param out Destination of one progress line per kernel
+ * @param options Filter, measuring time and threads
+ * @return Results in run order
+ */
+std::vector<BenchmarkResult> runBenchmarks(std::ostream& out,
+                                           const BenchmarkOptions& options) {
+  std::vector<BenchmarkResult> results;
+  const auto selected{[&](const std::string_view name) {
+    return name.find(options.filter) != std::string_view::npos;
+  }};
+  const auto report{[&](BenchmarkResult result) {
+    out << std::format("{:<36} {:>14.1f} ns/op\n", result.name,
+                       result.nsPerOp);
+    results.push_back(std::move(result));
+  }};
+
+  // Kernels time the computation, which the shared table would turn into
+  // lookups after the first operation
+  TranspositionTable::getInstance().setCapacity(0);
+
+  if (selected("utils/calculate_ab")) {
+    report(measure("utils/calculate_ab", options, [](const size_t i) {
+      const size_t count{utils::validNumbers.size()};
+      return utils::calculateAB(utils::validNumbers[i % count],
+                                utils::validNumbers[(i * 7 + 3) % count])[0];
+    }));
+  }
+
+  if (selected("utils/is_valid_guess")) {
+    report(measure("utils/is_valid_guess", options, [](const size_t i) {
+      return utils::isValidGuess(static_cast<int32_t>(i % 10000)).has_value();
+    }));
+  }
+
+  if (selected("search_space/apply_constraint")) {
+    // Includes restoring the full search space before each constraint
+    SearchSpaceManager searchSpace;
+    report(measure("search_space/apply_constraint", options,
+                   [&](const size_t i) {
+                     searchSpace.reset();
+                     searchSpace.applyConstraint(
+                         numberAt(1), 0, static_cast<int32_t>(i % 3));
+                     return searchSpace.getRemainingCount();
+                   }));
+  }
+
+  if (selected("search_space/get_possible_numbers")) {
+    const SearchSpaceManager searchSpace;
+    report(measure("search_space/get_possible_numbers", options,
+                   [&](size_t) {
+                     return searchSpace.getPossibleNumbers().size();
+                   }));
+  }
+
+  size_t previousSize{0};
+  for (const size_t size : positionSizes) {
+    const Position position{makePosition(size)};
+    const CandidateView candidates{position.searchSpace.getCandidates()};
+
+    // Small universes hold fewer numbers than the larger positions ask for
+    if (candidates.size() == previousSize) {
+      continue;
+    }
+    previousSize = candidates.size();
+
+    for (const auto& [strategy, key] : selectorStrategies) {
+      // Named after the candidates actually in the position
+      const std::string name{std::format("select_guess/{}/{}", key,
+                                         candidates.size())};
+      if (!selected(name)) {
+        continue;
+      }
+
+      // Caches are cleared so every operation scores the position afresh
+      StrategySelector selector{strategy};
+      selector.setWorkerCount(options.threadCount);
+      report(measure(name, options, [&](size_t) {
+        selector.clearCaches();
+        return selector.selectGuess(candidates, position.history);
+      }));
+    }
+  }
+
+  // Whole games against a spread of secrets, one game per operation
+  std::vector<int32_t> secrets;
+  for (size_t i{0}; i < utils::validNumbers.size(); i += 79) {
+    secrets.push_back(utils::validNumbers[i]);
+  }
+  for (const auto strategy : getAllStrategies()) {
+    const std::string name{std::format("game/{}", getStrategyKey(strategy))};
+    if (!selected(name)) {
+      continue;
+    }
+    // Without their opening books the exact searches take far longer than a
+    // benchmark run, so they are only timed when asked for by name
+    if ((strategy == HeuristicSolver::GuessStrategy::optimal ||
+         strategy == HeuristicSolver::GuessStrategy::worstCase) &&
+        options.filter.empty()) {
+      continue;
+    }
+
+    SimulationOptions game;
+    game.threadCount = 1;
+    game.secrets.resize(1);
+    report(measure(name, options, [&](const size_t i) {
+      game.secrets.front() = secrets[i % secrets.size()];
+      return simulateStrategy(strategy, game).solved;
+    }));
+  }
+
+  return results;
+}
+
+/**
+ * @brief Print results as a JSON document, one kernel per line
+ * @param out Destination stream
+ * @param options The options the results were produced with
+ * @param results Kernel timings
+ */
+void writeJson(std::ostream& out, const BenchmarkOptions& options,
+               const std::span<const BenchmarkResult> results) {
+  const auto flags{out.flags()};
+  const auto precision{out.precision()};
+  out << std::fixed << std::setprecision(3);
+
+  out << "{\n";
+  out << "  \"minSeconds\": " << options.minSeconds << ",\n";
+  out << "  \"repetitions\": " << options.repetitions << ",\n";
+  out << "  \"threads\": " << utils::resolveWorkerCount(options.threadCount)
+      << ",\n";
+  out << "  \"benchmarks\": [";
+  for (size_t i{0}; i < results.size(); ++i) {
+    const BenchmarkResult& result{results[i]};
+    out << (i == 0 ? "\n" : ",\n");
+    out << "    {\"name\": \"" << result.name
+        << "\", \"iterations\": " << result.iterations
+        << ", \"nsPerOp\": " << result.nsPerOp
+        << ", \"minNsPerOp\": " << result.minNsPerOp << "}";
+  }
+  out << (results.empty() ? "]\n" : "\n  ]\n");
+  out << "}\n";
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+/**
+ * @brief Read the median times of a file written by writeJson
+ * @param path The baseline file
+ * @return Time per operation by kernel name
+ * @throws std::runtime_error if the file cannot be read or holds no kernels
+ */
+std::map<std::string, double, std::less<>>
+readBaseline(const std::string& path) {
+  std::ifstream file{path};
+  if (!file) {
+    throw std::runtime_error("Cannot read baseline " + path);
+  }
+  const std::string text{std::istreambuf_iterator<char>{file},
+                         std::istreambuf_iterator<char>{}};
+
+  constexpr std::string_view nameKey{"\"name\": \""};
+  constexpr std::string_view timeKey{"\"nsPerOp\": "};
+  std::map<std::string, double, std::less<>> baseline;
+  for (size_t at{text.find(nameKey)}; at != std::string::npos;
+       at = text.find(nameKey, at)) {
+    const size_t nameStart{at + nameKey.size()};
+    const size_t nameEnd{text.find('"', nameStart)};
+    const size_t timeAt{text.find(timeKey, nameEnd)};
+    if (nameEnd == std::string::npos || timeAt == std::string::npos) {
+      break;
+    }
+
+    double nsPerOp{0.0};
+    const char* const timeStart{text.data() + timeAt + timeKey.size()};
+    if (const auto [end, error]{
+            std::from_chars(timeStart, text.data() + text.size(), nsPerOp)};
+        error != std::errc{}) {
+      throw std::runtime_error("Malformed baseline " + path);
+    }
+    baseline[text.substr(nameStart, nameEnd - nameStart)] = nsPerOp;
+    at = timeAt;
+  }
+
+  if (baseline.empty()) {
+    throw std::runtime_error("Baseline holds no benchmarks: " + path);
+  }
+  return baseline;
+}
+
+/**
+ * @brief Compare results with a baseline
+ * @param out Destination of the comparison table
+ * @param results Current timings
+ * @param baseline Baseline time per operation by kernel name
+ * @param thresholdPercent Allowed slowdown
+ * @return Whether every kernel is within the threshold
+ */
+bool compareWithBaseline(std::ostream& out,
+                         const std::span<const BenchmarkResult> results,
+                         const std::map<std::string, double, std::less<>>&
+                             baseline,
+                         const double thresholdPercent) {
+  bool passed{true};
+  out << std::format("{:<36} {:>14} {:>14} {:>9}\n", "Kernel", "Baseline ns",
+                     "Current ns", "Change");
+  for (const BenchmarkResult& result : results) {
+    const auto it{baseline.find(result.name)};
+    if (it == baseline.end()) {
+      out << std::format("{:<36} {:>14} {:>14.1f} {:>9}\n", result.name, "-",
+                         result.nsPerOp, "new");
+      continue;
+    }
+
+    const double change{(result.nsPerOp / it->second - 1.0) * 100.0};
+    const bool regressed{change > thresholdPercent};
+    passed = passed && !regressed;
+    out << std::format("{:<36} {:>14.1f} {:>14.1f} {:>+8.1f}%{}\n",
+                       result.name, it->second, result.nsPerOp, change,
+                       regressed ? "  REGRESSION" : "");
+  }
+  return passed;
+}
+
+/**
+ * @brief Parse a non-negative number option value
+ * @param name Option name for error messages
+ * @param text The value
+ * @return The parsed value
+ * @throws std::invalid_argument if the value is not a non-negative number
+ */
+template <typename T>
+T parseNumber(const std::string_view name, const std::string_view text) {
+  T value{};
+  if (const auto [end, error]{
+          std::from_chars(text.data(), text.data() + text.size(), value)};
+      error != std::errc{} || end != text.data() + text.size() ||
+      value < T{}) {
+    throw std::invalid_argument(std::string{name} +
+                                " expects a non-negative number");
+  }
+  return value;
+}
+
+void printUsage(const char* const program) {
+  std::cerr << "Usage: " << program
+            << " [--filter TEXT] [--min-time SECONDS] [--repetitions N]\n"
+               "       [--threads N] [--json FILE|-]\n"
+               "       [--compare BASELINE] [--threshold PERCENT]\n";
+}
+
+} // namespace
+
+int main(const int argc, char** argv) {
+  try {
+    BenchmarkOptions options;
+    std::optional<std::string> jsonPath;
+    std::optional<std::string> baselinePath;
+    double thresholdPercent{10.0};
+
+    for (int i{1}; i < argc; ++i) {
+      const std::string_view option{argv[i]};
+      if (option == "--help" || option == "-h") {
+        printUsage(argv[0]);
+        return 0;
+      }
+      if (i + 1 >= argc) {
+        printUsage(argv[0]);
+        return 2;
+      }
+
+      const std::string_view value{argv[++i]};
+      if (option == "--filter") {
+        options.filter = value;
+      } else if (option == "--min-time") {
+        options.minSeconds = parseNumber<double>(option, value);
+      } else if (option == "--repetitions") {
+        options.repetitions =
+            std::max<size_t>(parseNumber<size_t>(option, value), 1);
+      } else if (option == "--threads") {
+        options.threadCount = parseNumber<size_t>(option, value);
+      } else if (option == "--json") {
+        jsonPath = std::string{value};
+      } else if (option == "--compare") {
+        baselinePath = std::string{value};
+      } else if (option == "--threshold") {
+        thresholdPercent = parseNumber<double>(option, value);
+      } else {
+        printUsage(argv[0]);
+        return 2;
+      }
+    }
+
+    // Read the baseline first so a bad path fails before the long run
+    std::map<std::string, double, std::less<>> baseline;
+    if (baselinePath.has_value()) {
+      baseline = readBaseline(baselinePath.value());
+    }
+
+    const bool jsonToStdout{jsonPath.has_value() && jsonPath.value() == "-"};
+    std::ostream& text{jsonToStdout ? std::cerr : std::cout};
+    const std::vector<BenchmarkResult> results{runBenchmarks(text, options)};
+
+    if (jsonToStdout) {
+      writeJson(std::cout, options, results);
+    } else if (jsonPath.has_value()) {
+      std::ofstream file{jsonPath.value()};
+      writeJson(file, options, results);
+      if (!file) {
+        throw std::runtime_error("Cannot write " + jsonPath.value());
+      }
+    }
+
+    if (baselinePath.has_value()) {
+      text << '\n';
+      if (!compareWithBaseline(text, results, baseline, thresholdPercent)) {
+        text << std::format("Regression beyond {:.1f}%\n", thresholdPercent);
+        return 1;
+      }
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
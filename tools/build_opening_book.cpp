@@ -0,0 +1,72 @@
+/**
+ * @file build_opening_book.cpp
+ * @brief Offline generator for the solver's opening books
+ *
+ * Usage: 1a2b_book <output-directory> [depth] [strategy...]
+ */
+
+#include "../solver/opening_book.hpp"
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+int main(const int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <output-directory> [depth] [strategy...]\n"
+                 "Strategy keys: entropy, minimax, frequency, hybrid, "
+                 "optimal, worstcase\n";
+    return 2;
+  }
+
+  uint32_t depth{3};
+  if (argc >= 3) {
+    const std::string_view text{argv[2]};
+    if (const auto [end, error]{
+            std::from_chars(text.data(), text.data() + text.size(), depth)};
+        error != std::errc{} || end != text.data() + text.size() ||
+        depth == 0) {
+      std::cerr << "Depth must be a positive integer\n";
+      return 2;
+    }
+  }
+
+  // The books of the exact strategies search the whole game tree and are only
+  // built on request
+  std::vector<StrategySelector::StrategyType> strategies{
+      StrategySelector::StrategyType::entropyBased,
+      StrategySelector::StrategyType::miniMax,
+      StrategySelector::StrategyType::frequencyBased,
+      StrategySelector::StrategyType::hybrid};
+  if (argc > 3) {
+    strategies.clear();
+    for (int i{3}; i < argc; ++i) {
+      const auto strategy{StrategySelector::parseStrategyKey(argv[i])};
+      if (!strategy.has_value()) {
+        std::cerr << "Unknown strategy: " << argv[i] << "\n";
+        return 2;
+      }
+      strategies.push_back(strategy.value());
+    }
+  }
+
+  try {
+    const std::filesystem::path directory{argv[1]};
+    std::filesystem::create_directories(directory);
+
+    for (const auto strategy : strategies) {
+      const auto nodes{OpeningBook::generate(strategy, depth)};
+      const auto path{directory / OpeningBook::getFileName(strategy)};
+      OpeningBook::write(path, strategy, nodes);
+      std::cout << path.string() << ": " << nodes.size() << " positions\n";
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,60 @@
+/**
+ * @file compile_policy.cpp
+ * @brief Offline compiler of strategies into policy trees
+ *
+ * Usage: 1a2b_policy <output-directory> [strategy...]
+ *
+ * Opening books already in the output directory answer the first guesses, so
+ * the exact strategies compile much faster once their books are built.
+ */
+
+#include "../solver/opening_book.hpp"
+#include "../solver/policy_tree.hpp"
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+int main(const int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <output-directory> [strategy...]\n"
+              << "Strategy keys: entropy, minimax, frequency, hybrid, "
+                 "optimal, worstcase\n";
+    return 2;
+  }
+
+  std::vector<StrategySelector::StrategyType> strategies{
+      StrategySelector::StrategyType::entropyBased,
+      StrategySelector::StrategyType::miniMax,
+      StrategySelector::StrategyType::frequencyBased,
+      StrategySelector::StrategyType::hybrid};
+  if (argc > 2) {
+    strategies.clear();
+    for (int i{2}; i < argc; ++i) {
+      const auto strategy{StrategySelector::parseStrategyKey(argv[i])};
+      if (!strategy.has_value()) {
+        std::cerr << "Unknown strategy: " << argv[i] << "\n";
+        return 2;
+      }
+      strategies.push_back(strategy.value());
+    }
+  }
+
+  try {
+    const std::filesystem::path directory{argv[1]};
+    std::filesystem::create_directories(directory);
+    const auto books{OpeningBook::loadDirectory(directory)};
+
+    for (const auto strategy : strategies) {
+      const auto nodes{PolicyTree::compile(strategy, 0, books)};
+      const auto path{directory / PolicyTree::getFileName(strategy)};
+      PolicyTree::write(path, strategy, nodes);
+      std::cout << path.string() << ": " << nodes.size() << " positions, "
+                << PolicyTree{path}.getDepth() << " guesses at most\n";
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
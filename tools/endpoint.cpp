@@ -0,0 +1,132 @@
+/**
+ * @file endpoint.cpp
+ * @brief Implementation of the local socket helpers
+ */
+
+#include "endpoint.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Throw the error of the last failed system call
+ * @param what The operation that failed
+ * @throws std::runtime_error always
+ */
+[[noreturn]] void throwSystemError(const std::string_view what) {
+  throw std::runtime_error(std::string{what} + ": " + std::strerror(errno));
+}
+
+/**
+ * @brief Build the socket address of an endpoint
+ * @param endpoint The endpoint
+ * @param storage Address storage to fill
+ * @return Length of the address
+ * @throws std::invalid_argument if a Unix socket path is too long
+ */
+socklen_t toAddress(const Endpoint& endpoint, sockaddr_storage& storage) {
+  storage = {};
+  if (!endpoint.path.empty()) {
+    auto& address{reinterpret_cast<sockaddr_un&>(storage)};
+    if (endpoint.path.size() >= sizeof(address.sun_path)) {
+      throw std::invalid_argument("Unix socket path too long: " +
+                                  endpoint.path);
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, endpoint.path.data(), endpoint.path.size());
+    return sizeof(address);
+  }
+
+  auto& address{reinterpret_cast<sockaddr_in&>(storage)};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(endpoint.port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  return sizeof(address);
+}
+
+} // namespace
+
+Endpoint parseEndpoint(const std::string_view text) {
+  if (text.starts_with("unix:") && text.size() > 5) {
+    return {std::string{text.substr(5)}, 0};
+  }
+  if (text.starts_with("tcp:")) {
+    const std::string_view port{text.substr(4)};
+    uint16_t value{0};
+    if (const auto [end, error]{
+            std::from_chars(port.data(), port.data() + port.size(), value)};
+        error == std::errc{} && end == port.data() + port.size() &&
+        value != 0) {
+      return {{}, value};
+    }
+  }
+  throw std::invalid_argument("Expected unix:PATH or tcp:PORT, got " +
+                              std::string{text});
+}
+
+std::string formatEndpoint(const Endpoint& endpoint) {
+  if (!endpoint.path.empty()) {
+    return "unix:" + endpoint.path;
+  }
+  return "tcp:" + std::to_string(endpoint.port);
+}
+
+void setNoDelay(const int fd) {
+  // Fails harmlessly on Unix sockets, which do not batch writes anyway
+  const int enabled{1};
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+}
+
+int listenOn(const Endpoint& endpoint) {
+  sockaddr_storage storage{};
+  const socklen_t length{toAddress(endpoint, storage)};
+
+  const int fd{socket(storage.ss_family,
+                      SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)};
+  if (fd < 0) {
+    throwSystemError("socket");
+  }
+
+  if (endpoint.path.empty()) {
+    const int enabled{1};
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+  } else {
+    unlink(endpoint.path.c_str());
+  }
+
+  if (bind(fd, reinterpret_cast<const sockaddr*>(&storage), length) != 0 ||
+      listen(fd, SOMAXCONN) != 0) {
+    const int error{errno};
+    close(fd);
+    errno = error;
+    throwSystemError("listen on " + formatEndpoint(endpoint));
+  }
+  return fd;
+}
+
+int connectTo(const Endpoint& endpoint) {
+  sockaddr_storage storage{};
+  const socklen_t length{toAddress(endpoint, storage)};
+
+  const int fd{socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+  if (fd < 0) {
+    throwSystemError("socket");
+  }
+  if (connect(fd, reinterpret_cast<const sockaddr*>(&storage), length) != 0) {
+    const int error{errno};
+    close(fd);
+    errno = error;
+    throwSystemError("connect to " + formatEndpoint(endpoint));
+  }
+  setNoDelay(fd);
+  return fd;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file endpoint.hpp
+ * @brief Local socket addresses shared by the solver server and its clients
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @struct Endpoint
+ * @brief A Unix domain socket path or a loopback TCP port
+ */
+struct Endpoint {
+  std::string path; ///< Unix socket path, empty for TCP
+  uint16_t port{0}; ///< Loopback TCP port, used when path is empty
+};
+
+/**
+ * @brief Parse an endpoint given on the command line
+ * @param text "unix:PATH" or "tcp:PORT"
+ * @return The endpoint
+ * @throws std::invalid_argument if the text is neither form
+ */
+[[nodiscard]] Endpoint parseEndpoint(std::string_view text);
+
+/**
+ * @brief Get a printable form of an endpoint
+ * @param endpoint The endpoint
+ * @return The form parseEndpoint accepts
+ */
+[[nodiscard]] std::string formatEndpoint(const Endpoint& endpoint);
+
+/**
+ * @brief Disable Nagle's algorithm on a connected socket
+ * @param fd The socket
+ *
+ * Requests and replies are single short lines, which would otherwise wait
+ * for the acknowledgement of the previous one on TCP.
+ */
+void setNoDelay(int fd);
+
+/**
+ * @brief Open a non-blocking listening socket
+ * @param endpoint Where to listen; a stale Unix socket file is replaced
+ * @return The socket descriptor
+ * @throws std::runtime_error if the socket cannot be bound
+ */
+[[nodiscard]] int listenOn(const Endpoint& endpoint);
+
+/**
+ * @brief Open a blocking connection
+ * @param endpoint The server to connect to
+ * @return The socket descriptor
+ * @throws std::runtime_error if the connection fails
+ */
+[[nodiscard]] int connectTo(const Endpoint& endpoint);
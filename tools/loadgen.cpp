@@ -0,0 +1,374 @@
+/**
+ * @file loadgen.cpp
+ * @brief Load generator for the solver server
+ *
+ * Usage: 1a2b_loadgen [--connect unix:PATH|tcp:PORT] [--sessions N]
+ *                     [--concurrency N] [--connections N]
+ *                     [--strategy KEY] [--seed S]
+ *
+ * Plays N games (10000 by default) against a running 1a2b_server, with
+ * secrets drawn at random from the valid numbers. The games are spread over
+ * several connections, each on a thread of its own that keeps its share of
+ * the concurrent games in flight by pipelining their requests. Reports the
+ * throughput in games and requests per second and the latency percentiles of
+ * single requests, measured from sending a request to reading its reply.
+ */
+
+#include "../utils/number_universe.hpp"
+#include "../utils/utils.hpp"
+#include "endpoint.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @struct LoadOptions
+ * @brief What load to put on the server
+ */
+struct LoadOptions {
+  Endpoint endpoint{"/tmp/1a2b.sock", 0}; ///< Server to connect to
+  size_t sessionCount{10000};             ///< Games to play in total
+  size_t concurrency{64};                 ///< Games in flight at once
+  size_t connectionCount{4};              ///< Connections, one thread each
+  std::string strategy{"hybrid"};         ///< Strategy key of every game
+  uint64_t seed{0};                       ///< Seed of the secrets
+};
+
+/**
+ * @struct ConnectionStats
+ * @brief Measurements of one connection
+ */
+struct ConnectionStats {
+  std::vector<double> latencies; ///< Seconds per request, in reply order
+  uint64_t solved{0};            ///< Games the server solved
+  uint64_t guesses{0};           ///< Guesses over the solved games
+  uint64_t errors{0};            ///< ERR replies
+};
+
+/**
+ * @struct Game
+ * @brief A game in flight on a connection
+ */
+struct Game {
+  int32_t secret{0};           ///< Number the server has to find
+  Clock::time_point requested; ///< When the pending request was sent
+};
+
+/**
+ * @brief Parse a non-negative integer option value
+ * @param name Option name for error messages
+ * @param text The value
+ * @return The parsed value
+ * @throws std::invalid_argument if the value is not a non-negative integer
+ */
+template <typename T>
+T parseNumber(const std::string_view name, const std::string_view text) {
+  T value{};
+  if (const auto [end, error]{
+          std::from_chars(text.data(), text.data() + text.size(), value)};
+      error != std::errc{} || end != text.data() + text.size()) {
+    throw std::invalid_argument(std::string{name} +
+                                " expects a non-negative integer");
+  }
+  return value;
+}
+
+void printUsage(const char* const program) {
+  std::cerr << "Usage: " << program
+            << " [--connect unix:PATH|tcp:PORT] [--sessions N]\n"
+               "       [--concurrency N] [--connections N]\n"
+               "       [--strategy KEY] [--seed S]\n";
+}
+
+/**
+ * @brief Parse a number of a reply
+ * @param text The number
+ * @param base Base it is written in
+ * @return The number, or -1 if the text is not one
+ */
+int32_t parseReplyNumber(const std::string_view text, const int32_t base) {
+  int32_t value{0};
+  if (const auto [end, error]{std::from_chars(
+          text.data(), text.data() + text.size(), value, base)};
+      error != std::errc{} || end != text.data() + text.size()) {
+    return -1;
+  }
+  return value;
+}
+
+/**
+ * @brief Send a whole buffer on a blocking socket
+ * @param fd The socket
+ * @param data Bytes to send, cleared once sent
+ * @throws std::runtime_error if the server hangs up
+ */
+void sendAll(const int fd, std::string& data) {
+  for (size_t sent{0}; sent < data.size();) {
+    const ssize_t length{
+        send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL)};
+    if (length < 0 && errno != EINTR) {
+      throw std::runtime_error(std::string{"send: "} + std::strerror(errno));
+    }
+    sent += static_cast<size_t>(std::max<ssize_t>(length, 0));
+  }
+  data.clear();
+}
+
+/**
+ * @brief Play a share of the games over one connection
+ * @param options The load
+ * @param sessionCount Games to play on this connection
+ * @param concurrency Games in flight on this connection, at least 1
+ * @param seed Seed of this connection's secrets
+ * @return Measurements of the connection
+ * @throws std::runtime_error if the connection fails or the server replies
+ *         with something unexpected
+ */
+ConnectionStats playGames(const LoadOptions& options,
+                          const size_t sessionCount, const size_t concurrency,
+                          const uint64_t seed) {
+  ConnectionStats stats;
+  stats.latencies.reserve(sessionCount * 8);
+  if (sessionCount == 0) {
+    return stats;
+  }
+
+  const int fd{connectTo(options.endpoint)};
+  std::mt19937_64 engine{seed};
+  std::uniform_int_distribution<size_t> pick{0,
+                                             utils::validNumbers.size() - 1};
+
+  // Games are identified by their slot, which the next game reuses
+  std::vector<Game> games(std::min(concurrency, sessionCount));
+  size_t started{0};
+  size_t finished{0};
+  std::string requests;
+
+  const auto startGame{[&](const size_t slot) {
+    games[slot].secret = utils::validNumbers[pick(engine)];
+    games[slot].requested = Clock::now();
+    requests.append(std::format("NEW {} {}\n", slot, options.strategy));
+    ++started;
+  }};
+
+  const auto handleReply{[&](std::string_view rest) {
+    const std::string_view verb{utils::nextToken(rest)};
+    const int32_t slot{parseReplyNumber(utils::nextToken(rest), 10)};
+    const std::string_view value{utils::nextToken(rest)};
+    if (slot < 0 || static_cast<size_t>(slot) >= games.size()) {
+      throw std::runtime_error("Unexpected reply: " + std::string{verb});
+    }
+
+    Game& game{games[static_cast<size_t>(slot)]};
+    const auto now{Clock::now()};
+    stats.latencies.push_back(
+        std::chrono::duration<double>(now - game.requested).count());
+
+    if (verb == "GUESS") {
+      const int32_t guess{parseReplyNumber(value, utils::alphabetSize)};
+      if (guess < 0) {
+        throw std::runtime_error("Unreadable guess: " + std::string{value});
+      }
+      const auto [aCount, bCount]{utils::calculateAB(guess, game.secret)};
+      game.requested = now;
+      requests.append(std::format("FB {} {}A{}B\n", slot, aCount, bCount));
+      return;
+    }
+
+    if (verb == "SOLVED") {
+      ++stats.solved;
+      stats.guesses += static_cast<uint64_t>(
+          std::max(parseReplyNumber(value, 10), 0));
+    } else if (verb == "ERR") {
+      ++stats.errors;
+    } else {
+      throw std::runtime_error("Unexpected reply: " + std::string{verb});
+    }
+    ++finished;
+    if (started < sessionCount) {
+      startGame(static_cast<size_t>(slot));
+    }
+  }};
+
+  for (size_t slot{0}; slot < games.size(); ++slot) {
+    startGame(slot);
+  }
+
+  std::array<char, 64 * 1024> buffer{};
+  std::string input;
+  try {
+    while (finished < sessionCount) {
+      sendAll(fd, requests);
+
+      const ssize_t length{recv(fd, buffer.data(), buffer.size(), 0)};
+      if (length < 0 && errno == EINTR) {
+        continue;
+      }
+      if (length <= 0) {
+        throw std::runtime_error("Server closed the connection");
+      }
+      input.append(buffer.data(), static_cast<size_t>(length));
+
+      // Answer every whole reply, then send the answers in one write
+      size_t begin{0};
+      for (size_t end{input.find('\n')}; end != std::string::npos;
+           end = input.find('\n', begin)) {
+        handleReply(std::string_view{input}.substr(begin, end - begin));
+        begin = end + 1;
+      }
+      input.erase(0, begin);
+    }
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+  return stats;
+}
+
+/**
+ * @brief Get a percentile of sorted samples
+ * @param sorted Samples in ascending order, not empty
+ * @param fraction Percentile as a fraction in [0, 1]
+ * @return The nearest-rank percentile
+ */
+double percentile(const std::vector<double>& sorted, const double fraction) {
+  const auto rank{static_cast<size_t>(
+      fraction * static_cast<double>(sorted.size() - 1) + 0.5)};
+  return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+} // namespace
+
+int main(const int argc, char** argv) {
+  try {
+    LoadOptions options;
+    options.seed = std::random_device{}();
+
+    for (int i{1}; i < argc; ++i) {
+      const std::string_view option{argv[i]};
+      if (option == "--help" || option == "-h") {
+        printUsage(argv[0]);
+        return 0;
+      }
+      if (i + 1 >= argc) {
+        printUsage(argv[0]);
+        return 2;
+      }
+
+      const std::string_view value{argv[++i]};
+      if (option == "--connect") {
+        options.endpoint = parseEndpoint(value);
+      } else if (option == "--sessions") {
+        options.sessionCount = parseNumber<size_t>(option, value);
+      } else if (option == "--concurrency") {
+        options.concurrency = parseNumber<size_t>(option, value);
+      } else if (option == "--connections") {
+        options.connectionCount = parseNumber<size_t>(option, value);
+      } else if (option == "--strategy") {
+        options.strategy = std::string{value};
+      } else if (option == "--seed") {
+        options.seed = parseNumber<uint64_t>(option, value);
+      } else {
+        printUsage(argv[0]);
+        return 2;
+      }
+    }
+
+    const size_t connections{std::max<size_t>(options.connectionCount, 1)};
+    const size_t concurrency{std::max(options.concurrency, connections)};
+
+    // Each connection gets an even share of the games and of the concurrency
+    std::vector<ConnectionStats> stats(connections);
+    std::vector<std::exception_ptr> failures(connections);
+    const auto start{Clock::now()};
+    {
+      std::vector<std::jthread> threads;
+      threads.reserve(connections);
+      for (size_t connection{0}; connection < connections; ++connection) {
+        const auto share{[&](const size_t total) {
+          return total / connections +
+                 (connection < total % connections ? 1 : 0);
+        }};
+        threads.emplace_back([&, connection,
+                              sessionCount = share(options.sessionCount),
+                              inFlight = share(concurrency)] {
+          try {
+            stats[connection] = playGames(options, sessionCount, inFlight,
+                                          options.seed ^ connection);
+          } catch (...) {
+            failures[connection] = std::current_exception();
+          }
+        });
+      }
+    }
+    const double seconds{
+        std::chrono::duration<double>(Clock::now() - start).count()};
+
+    for (const std::exception_ptr& failure : failures) {
+      if (failure) {
+        std::rethrow_exception(failure);
+      }
+    }
+
+    ConnectionStats totals;
+    for (ConnectionStats& connection : stats) {
+      totals.latencies.insert(totals.latencies.end(),
+                              connection.latencies.begin(),
+                              connection.latencies.end());
+      totals.solved += connection.solved;
+      totals.guesses += connection.guesses;
+      totals.errors += connection.errors;
+    }
+    std::ranges::sort(totals.latencies);
+
+    const double games{static_cast<double>(totals.solved + totals.errors)};
+    std::cout << std::format(
+        "Endpoint:     {}\n"
+        "Games:        {} solved, {} failed, {} connection(s), {} in flight\n"
+        "Seed:         {}\n"
+        "Throughput:   {:.1f} games/s, {:.1f} requests/s over {:.2f} s\n",
+        formatEndpoint(options.endpoint), totals.solved, totals.errors,
+        connections, concurrency, options.seed, games / seconds,
+        static_cast<double>(totals.latencies.size()) / seconds, seconds);
+    if (totals.solved > 0) {
+      std::cout << std::format("Mean guesses: {:.4f}\n",
+                               static_cast<double>(totals.guesses) /
+                                   static_cast<double>(totals.solved));
+    }
+    if (!totals.latencies.empty()) {
+      const auto milliseconds{[&totals](const double fraction) {
+        return percentile(totals.latencies, fraction) * 1e3;
+      }};
+      std::cout << std::format("Latency ms:   p50 {:.3f}, p90 {:.3f}, "
+                               "p99 {:.3f}, p99.9 {:.3f}, max {:.3f}\n",
+                               milliseconds(0.5), milliseconds(0.9),
+                               milliseconds(0.99), milliseconds(0.999),
+                               milliseconds(1.0));
+    }
+    return totals.errors == 0 ? 0 : 1;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
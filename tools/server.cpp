@@ -0,0 +1,823 @@
+/**
+ * @file server.cpp
+ * @brief Multi-session solver server on a local socket
+ *
+ * Usage: 1a2b_server [--listen unix:PATH|tcp:PORT] [--threads N]
+ *                    [--books DIR]
+ *
+ * Serves the line protocol of `1a2b --protocol` (see ProtocolServer) to any
+ * number of clients over a Unix domain socket or a loopback TCP port. One
+ * thread runs an epoll loop over every socket and owns every session, which
+ * is a compact SolverSession of its candidates and turns. Guesses are
+ * computed for the sessions by a pool of worker threads sharing one
+ * SolverEngine, so idle sessions cost no solver and repeated positions are
+ * answered from the process-wide TranspositionTable.
+ *
+ * Session ids are scoped to their connection and end with it. Replies to
+ * different sessions may arrive out of request order; a request for a session
+ * whose guess is still being computed is answered with `ERR <id> busy`.
+ * SIGINT and SIGTERM stop the server, which then prints its totals.
+ */
+
+#include "../solver/opening_book.hpp"
+#include "../solver/solver_engine.hpp"
+#include "../utils/parallel.hpp"
+#include "../utils/utils.hpp"
+#include "endpoint.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t maxRequestLength{4096}; ///< Longer lines drop the client
+constexpr size_t readChunk{64 * 1024};   ///< Bytes read per recv call
+
+constexpr uint64_t listenKey{0}; ///< epoll key of the listening socket
+constexpr uint64_t wakeKey{1};   ///< epoll key of the worker eventfd
+constexpr uint64_t signalKey{2}; ///< epoll key of the signalfd
+
+/**
+ * @brief Parse a non-negative integer option value
+ * @param name Option name for error messages
+ * @param text The value
+ * @return The parsed value
+ * @throws std::invalid_argument if the value is not a non-negative integer
+ */
+template <typename T>
+T parseNumber(const std::string_view name, const std::string_view text) {
+  T value{};
+  if (const auto [end, error]{
+          std::from_chars(text.data(), text.data() + text.size(), value)};
+      error != std::errc{} || end != text.data() + text.size()) {
+    throw std::invalid_argument(std::string{name} +
+                                " expects a non-negative integer");
+  }
+  return value;
+}
+
+void printUsage(const char* const program) {
+  std::cerr << "Usage: " << program
+            << " [--listen unix:PATH|tcp:PORT] [--threads N]\n"
+               "       [--books DIR]\n";
+}
+
+/**
+ * @brief Throw the error of the last failed system call
+ * @param what The operation that failed
+ * @throws std::runtime_error always
+ */
+[[noreturn]] void throwSystemError(const std::string_view what) {
+  throw std::runtime_error(std::string{what} + ": " + std::strerror(errno));
+}
+
+/**
+ * @struct Job
+ * @brief A guess to compute for a session
+ */
+struct Job {
+  uint64_t connection;   ///< Key of the client connection
+  uint64_t ticket;       ///< Request the guess answers
+  std::string sessionId; ///< Session within the connection
+  SolverSession game;    ///< Copy of the session's game
+};
+
+/**
+ * @struct Outcome
+ * @brief A computed guess, or why there is none
+ */
+struct Outcome {
+  uint64_t connection;          ///< Key of the client connection
+  uint64_t ticket;              ///< Request the guess answers
+  std::string sessionId;        ///< Session within the connection
+  std::optional<int32_t> guess; ///< The guess, if one was found
+  std::string error;            ///< Reason there is no guess
+};
+
+/**
+ * @class WorkerPool
+ * @brief Threads computing guesses for the event loop
+ *
+ * Jobs are taken in submission order. Each finished job is queued as an
+ * Outcome and announced by incrementing an eventfd the event loop polls.
+ */
+class WorkerPool {
+public:
+  /**
+   * @brief Start the workers
+   * @param workerCount Number of threads, at least 1
+   * @param engine Engine computing the guesses, outliving the pool
+   * @param wakeFd eventfd signalled whenever outcomes are ready
+   */
+  WorkerPool(const size_t workerCount, const SolverEngine& engine,
+             const int wakeFd)
+      : m_engine{engine}, m_wakeFd{wakeFd} {
+    m_threads.reserve(workerCount);
+    for (size_t worker{0}; worker < std::max<size_t>(workerCount, 1);
+         ++worker) {
+      m_threads.emplace_back(
+          [this](const std::stop_token stop) { work(stop); });
+    }
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /**
+   * @brief Stop the workers once their current jobs are done
+   *
+   * Jobs still queued are dropped.
+   */
+  ~WorkerPool() {
+    for (std::jthread& thread : m_threads) {
+      thread.request_stop();
+    }
+  }
+
+  /**
+   * @brief Queue a job
+   * @param job The guess to compute
+   */
+  void submit(Job job) {
+    {
+      const std::scoped_lock lock{m_jobMutex};
+      m_jobs.push_back(std::move(job));
+    }
+    m_jobReady.notify_one();
+  }
+
+  /**
+   * @brief Take every outcome finished so far
+   * @return The outcomes, oldest first
+   */
+  [[nodiscard]] std::vector<Outcome> takeOutcomes() {
+    std::vector<Outcome> outcomes;
+    const std::scoped_lock lock{m_outcomeMutex};
+    outcomes.swap(m_outcomes);
+    return outcomes;
+  }
+
+private:
+  /**
+   * @brief Compute guesses until stopped
+   * @param stop Requested by the destructor
+   */
+  void work(const std::stop_token stop) {
+    for (;;) {
+      Job job;
+      {
+        std::unique_lock lock{m_jobMutex};
+        // The wait reports queued jobs even once a stop has been requested
+        if (!m_jobReady.wait(lock, stop, [this] { return !m_jobs.empty(); }) ||
+            stop.stop_requested()) {
+          return;
+        }
+        job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+      }
+
+      Outcome outcome{job.connection, job.ticket, std::move(job.sessionId),
+                      std::nullopt, {}};
+      try {
+        outcome.guess = m_engine.nextGuess(job.game);
+        if (!outcome.guess.has_value()) {
+          outcome.error = "no candidates left";
+        }
+      } catch (const std::exception& e) {
+        outcome.error = e.what();
+      }
+
+      {
+        const std::scoped_lock lock{m_outcomeMutex};
+        m_outcomes.push_back(std::move(outcome));
+      }
+      const uint64_t increment{1};
+      [[maybe_unused]] const ssize_t written{
+          write(m_wakeFd, &increment, sizeof(increment))};
+    }
+  }
+
+  const SolverEngine& m_engine;           ///< Engine computing the guesses
+  int m_wakeFd;                           ///< eventfd announcing outcomes
+  std::mutex m_jobMutex;                  ///< Guards m_jobs
+  std::condition_variable_any m_jobReady; ///< Signalled on submit
+  std::deque<Job> m_jobs;                 ///< Jobs not yet taken
+  std::mutex m_outcomeMutex;              ///< Guards m_outcomes
+  std::vector<Outcome> m_outcomes;        ///< Outcomes not yet taken
+  std::vector<std::jthread> m_threads;    ///< Workers; joined first on exit
+};
+
+/**
+ * @struct Session
+ * @brief State of one client game between requests
+ */
+struct Session {
+  SolverSession game; ///< Candidates and answered guesses
+  int32_t guess{0};   ///< Last guess sent
+  uint64_t ticket{0}; ///< Pending guess, 0 if idle
+};
+
+/**
+ * @struct IdHash
+ * @brief Hash that looks up sessions by string_view without copying
+ */
+struct IdHash {
+  using is_transparent = void;
+
+  [[nodiscard]] size_t operator()(const std::string_view id) const {
+    return std::hash<std::string_view>{}(id);
+  }
+};
+
+/**
+ * @struct Connection
+ * @brief A client socket and its sessions
+ */
+struct Connection {
+  int fd{-1};          ///< Non-blocking socket
+  std::string input;   ///< Received bytes not yet forming a whole line
+  std::string output;  ///< Replies not yet sent
+  size_t sent{0};      ///< Bytes of output already sent
+  uint32_t events{0};  ///< Events registered with epoll
+  bool closing{false}; ///< Whether the client has stopped sending
+  std::unordered_map<std::string, Session, IdHash, std::equal_to<>>
+      sessions; ///< Sessions by id
+};
+
+/**
+ * @struct Totals
+ * @brief Counters reported when the server stops
+ */
+struct Totals {
+  uint64_t connections{0}; ///< Connections accepted
+  uint64_t requests{0};    ///< Request lines handled
+  uint64_t guesses{0};     ///< Guesses computed by the workers
+  uint64_t solved{0};      ///< Sessions that reached all digits right
+};
+
+/**
+ * @class EventLoop
+ * @brief Accepts clients, parses requests and sends replies on one thread
+ */
+class EventLoop {
+public:
+  /**
+   * @brief Set up polling of the listening socket, eventfd and signalfd
+   * @param listenFd Non-blocking listening socket
+   * @param wakeFd eventfd the workers signal
+   * @param signalFd signalfd of the stopping signals
+   * @param pool Workers computing guesses
+   */
+  EventLoop(const int listenFd, const int wakeFd, const int signalFd,
+            WorkerPool& pool)
+      : m_epollFd{epoll_create1(EPOLL_CLOEXEC)}, m_listenFd{listenFd},
+        m_wakeFd{wakeFd}, m_signalFd{signalFd}, m_pool{pool} {
+    if (m_epollFd < 0) {
+      throwSystemError("epoll_create1");
+    }
+    watch(m_listenFd, listenKey, EPOLLIN);
+    watch(m_wakeFd, wakeKey, EPOLLIN);
+    watch(m_signalFd, signalKey, EPOLLIN);
+  }
+
+  EventLoop(const EventLoop&) = delete;
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  ~EventLoop() {
+    for (const auto& [key, connection] : m_connections) {
+      close(connection.fd);
+    }
+    close(m_epollFd);
+  }
+
+  /**
+   * @brief Serve clients until a stopping signal arrives
+   * @return Counters of the run
+   */
+  Totals run() {
+    std::array<epoll_event, 256> events{};
+    for (;;) {
+      const int ready{epoll_wait(m_epollFd, events.data(),
+                                 static_cast<int>(events.size()), -1)};
+      if (ready < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throwSystemError("epoll_wait");
+      }
+
+      for (const epoll_event& event :
+           std::span{events.data(), static_cast<size_t>(ready)}) {
+        switch (event.data.u64) {
+        case listenKey:
+          acceptClients();
+          break;
+        case wakeKey:
+          deliverOutcomes();
+          break;
+        case signalKey:
+          return m_totals;
+        default:
+          serveClient(event.data.u64, event.events);
+          break;
+        }
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief Register a descriptor with epoll
+   * @param fd The descriptor
+   * @param key Value reported with its events
+   * @param events Events to wait for
+   */
+  void watch(const int fd, const uint64_t key, const uint32_t events) {
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = key;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+      throwSystemError("epoll_ctl");
+    }
+  }
+
+  /**
+   * @brief Accept every pending client
+   *
+   * When the process runs out of descriptors the pending clients stay in the
+   * backlog, which would keep the listening socket readable and the loop
+   * spinning, so it is not polled again until a client disconnects.
+   */
+  void acceptClients() {
+    for (;;) {
+      const int fd{accept4(m_listenFd, nullptr, nullptr,
+                           SOCK_NONBLOCK | SOCK_CLOEXEC)};
+      if (fd < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) {
+          continue;
+        }
+        if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS ||
+            errno == ENOMEM) {
+          pauseAccepting(true);
+        }
+        return; // EAGAIN once the backlog is empty
+      }
+      setNoDelay(fd);
+
+      const uint64_t key{m_nextKey++};
+      Connection& connection{m_connections[key]};
+      connection.fd = fd;
+      connection.events = EPOLLIN | EPOLLRDHUP;
+      watch(fd, key, connection.events);
+      ++m_totals.connections;
+    }
+  }
+
+  /**
+   * @brief Stop or resume polling the listening socket
+   * @param paused Whether to stop polling it
+   */
+  void pauseAccepting(const bool paused) {
+    if (paused == m_acceptPaused) {
+      return;
+    }
+    epoll_event event{};
+    event.events = paused ? 0U : static_cast<uint32_t>(EPOLLIN);
+    event.data.u64 = listenKey;
+    epoll_ctl(m_epollFd, EPOLL_CTL_MOD, m_listenFd, &event);
+    m_acceptPaused = paused;
+  }
+
+  /**
+   * @brief Drop a client and its sessions
+   * @param key The connection's key
+   *
+   * Guesses still being computed for it are discarded when they arrive.
+   */
+  void disconnect(const uint64_t key) {
+    if (const auto connection{m_connections.find(key)};
+        connection != m_connections.end()) {
+      close(connection->second.fd); // Also removes it from the epoll set
+      m_connections.erase(connection);
+
+      // The freed descriptor may let a waiting client in
+      pauseAccepting(false);
+    }
+  }
+
+  /**
+   * @brief Handle readiness of a client socket
+   * @param key The connection's key
+   * @param events Events reported by epoll
+   */
+  void serveClient(const uint64_t key, const uint32_t events) {
+    const auto found{m_connections.find(key)};
+    if (found == m_connections.end()) {
+      return;
+    }
+    Connection& connection{found->second};
+
+    if ((events & EPOLLIN) != 0 && !receive(key, connection)) {
+      return;
+    }
+    if ((events & (EPOLLERR | EPOLLHUP)) != 0) {
+      disconnect(key);
+      return;
+    }
+    send(key, connection);
+  }
+
+  /**
+   * @brief Check whether a client that stopped sending has been fully served
+   * @param connection The connection
+   * @return true if no reply is pending or being computed
+   */
+  [[nodiscard]] static bool isDrained(const Connection& connection) {
+    return connection.closing && connection.output.empty() &&
+           std::ranges::none_of(connection.sessions, [](const auto& entry) {
+             return entry.second.ticket != 0;
+           });
+  }
+
+  /**
+   * @brief Read and answer every complete request of a client
+   * @param key The connection's key
+   * @param connection The connection
+   * @return false if the client was dropped
+   */
+  bool receive(const uint64_t key, Connection& connection) {
+    std::array<char, readChunk> buffer{};
+    for (;;) {
+      const ssize_t length{
+          recv(connection.fd, buffer.data(), buffer.size(), 0)};
+      if (length < 0 && errno != EAGAIN && errno != EINTR) {
+        disconnect(key);
+        return false;
+      }
+      if (length == 0) {
+        // The client may still wait for the replies to what it sent
+        connection.closing = true;
+        return true;
+      }
+      if (length < 0) {
+        return true;
+      }
+      connection.input.append(buffer.data(), static_cast<size_t>(length));
+
+      // Answering each chunk at once bounds the input of a client that
+      // never ends its line
+      size_t begin{0};
+      for (size_t end{connection.input.find('\n')};
+           end != std::string::npos;
+           end = connection.input.find('\n', begin)) {
+        handleRequest(key, connection,
+                      std::string_view{connection.input}.substr(begin,
+                                                                end - begin));
+        begin = end + 1;
+      }
+      connection.input.erase(0, begin);
+
+      if (connection.input.size() > maxRequestLength) {
+        disconnect(key);
+        return false;
+      }
+    }
+  }
+
+  /**
+   * @brief Send as much buffered output to a client as it accepts
+   * @param key The connection's key
+   * @param connection The connection, dropped once a closing client is
+   * drained
+   */
+  void send(const uint64_t key, Connection& connection) {
+    while (connection.sent < connection.output.size()) {
+      const ssize_t length{::send(connection.fd,
+                                  connection.output.data() + connection.sent,
+                                  connection.output.size() - connection.sent,
+                                  MSG_NOSIGNAL)};
+      if (length < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+          break;
+        }
+        disconnect(key);
+        return;
+      }
+      connection.sent += static_cast<size_t>(length);
+    }
+
+    if (connection.sent == connection.output.size()) {
+      connection.output.clear();
+      connection.sent = 0;
+    }
+
+    if (isDrained(connection)) {
+      disconnect(key);
+      return;
+    }
+
+    // Ask for writability only while replies are held back, and stop
+    // reading from a client that has closed its side
+    const uint32_t events{
+        (connection.closing ? 0U : EPOLLIN | EPOLLRDHUP) |
+        (connection.output.empty() ? 0U : static_cast<uint32_t>(EPOLLOUT))};
+    if (events != connection.events) {
+      epoll_event event{};
+      event.events = events;
+      event.data.u64 = key;
+      epoll_ctl(m_epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+      connection.events = events;
+    }
+  }
+
+  /**
+   * @brief Append a reply line
+   * @param connection The connection to reply on
+   * @param verb First token of the reply
+   * @param id The session id
+   * @param value Rest of the reply, if any
+   */
+  static void reply(Connection& connection, const std::string_view verb,
+                    const std::string_view id,
+                    const std::string_view value = {}) {
+    std::string& output{connection.output};
+    output.append(verb).append(1, ' ').append(id);
+    if (!value.empty()) {
+      output.append(1, ' ').append(value);
+    }
+    output.append(1, '\n');
+  }
+
+  /**
+   * @brief Append a reply line ending in a number
+   * @param connection The connection to reply on
+   * @param verb First token of the reply
+   * @param id The session id
+   * @param value The number
+   * @param base Base the number is written in
+   */
+  static void reply(Connection& connection, const std::string_view verb,
+                    const std::string_view id, const int32_t value,
+                    const int base) {
+    std::array<char, 16> digits{};
+    const char* const end{
+        std::to_chars(digits.data(), digits.data() + digits.size(), value, base)
+            .ptr};
+    reply(connection, verb, id,
+          std::string_view{digits.data(),
+                           static_cast<size_t>(end - digits.data())});
+  }
+
+  /**
+   * @brief Queue the next guess of a session
+   * @param key The connection's key
+   * @param id The session id
+   * @param session The session, which is busy until the guess arrives
+   */
+  void requestGuess(const uint64_t key, const std::string_view id,
+                    Session& session) {
+    session.ticket = m_nextTicket++;
+    m_pool.submit(Job{key, session.ticket, std::string{id}, session.game});
+  }
+
+  /**
+   * @brief Answer one request line
+   * @param key The connection's key
+   * @param connection The connection
+   * @param request The line, without its line break
+   */
+  void handleRequest(const uint64_t key, Connection& connection,
+                     const std::string_view request) {
+    std::string_view rest{request};
+    if (!rest.empty() && rest.back() == '\r') {
+      rest.remove_suffix(1);
+    }
+
+    const std::string_view command{utils::nextToken(rest)};
+    if (command.empty()) {
+      return;
+    }
+    ++m_totals.requests;
+
+    const std::string_view id{utils::nextToken(rest)};
+    const std::string_view argument{utils::nextToken(rest)};
+    if (id.empty()) {
+      reply(connection, "ERR", "-", "missing session id");
+      return;
+    }
+
+    auto session{connection.sessions.find(id)};
+    if (session != connection.sessions.end() && session->second.ticket != 0 &&
+        command != "END") {
+      reply(connection, "ERR", id, "busy");
+      return;
+    }
+
+    if (command == "NEW") {
+      const auto strategy{StrategySelector::parseStrategyKey(argument)};
+      if (!strategy.has_value()) {
+        reply(connection, "ERR", id, "unknown strategy");
+        return;
+      }
+      if (session == connection.sessions.end()) {
+        session = connection.sessions.try_emplace(std::string{id}).first;
+      }
+      session->second = Session{SolverSession{strategy.value()}, 0, 0};
+      requestGuess(key, id, session->second);
+    } else if (command == "FB") {
+      if (session == connection.sessions.end()) {
+        reply(connection, "ERR", id, "unknown session");
+        return;
+      }
+      const auto counts{utils::parseFeedback(argument)};
+      if (!counts.has_value()) {
+        reply(connection, "ERR", id, "invalid feedback");
+        return;
+      }
+
+      Session& state{session->second};
+      const auto [aCount, bCount]{counts.value()};
+      if (aCount == utils::numberSize) {
+        reply(connection, "SOLVED", id,
+              static_cast<int32_t>(state.game.getTurns().size() + 1), 10);
+        connection.sessions.erase(session);
+        ++m_totals.solved;
+        return;
+      }
+      state.game.updateGuess(state.guess, aCount, bCount);
+      requestGuess(key, id, state);
+    } else if (command == "END") {
+      if (session != connection.sessions.end()) {
+        connection.sessions.erase(session);
+      }
+      reply(connection, "OK", id);
+    } else {
+      reply(connection, "ERR", id, "unknown command");
+    }
+  }
+
+  /**
+   * @brief Send the guesses the workers have finished
+   */
+  void deliverOutcomes() {
+    uint64_t count{0};
+    [[maybe_unused]] const ssize_t length{
+        read(m_wakeFd, &count, sizeof(count))};
+
+    std::vector<uint64_t> touched;
+    for (Outcome& outcome : m_pool.takeOutcomes()) {
+      ++m_totals.guesses;
+      const auto connection{m_connections.find(outcome.connection)};
+      if (connection == m_connections.end()) {
+        continue;
+      }
+      auto& sessions{connection->second.sessions};
+      const auto session{sessions.find(outcome.sessionId)};
+      if (session == sessions.end() ||
+          session->second.ticket != outcome.ticket) {
+        continue; // Ended or restarted while the guess was computed
+      }
+
+      session->second.ticket = 0;
+      if (outcome.guess.has_value()) {
+        session->second.guess = outcome.guess.value();
+        reply(connection->second, "GUESS", outcome.sessionId,
+              outcome.guess.value(), utils::alphabetSize);
+      } else {
+        reply(connection->second, "ERR", outcome.sessionId, outcome.error);
+        sessions.erase(session);
+      }
+      touched.push_back(outcome.connection);
+    }
+
+    // Replies are sent once per connection however many guesses it got
+    for (const uint64_t key : touched) {
+      if (const auto connection{m_connections.find(key)};
+          connection != m_connections.end()) {
+        send(key, connection->second);
+      }
+    }
+  }
+
+  int m_epollFd;      ///< The epoll instance
+  int m_listenFd;     ///< Listening socket
+  int m_wakeFd;       ///< eventfd the workers signal
+  int m_signalFd;     ///< signalfd of SIGINT and SIGTERM
+  WorkerPool& m_pool; ///< Workers computing guesses
+  std::unordered_map<uint64_t, Connection>
+      m_connections;                 ///< Clients by key
+  uint64_t m_nextKey{signalKey + 1}; ///< Key of the next client
+  uint64_t m_nextTicket{1};          ///< Ticket of the next guess request
+  Totals m_totals;                   ///< Counters of the run
+  bool m_acceptPaused{false};        ///< Whether the listening socket is idle
+};
+
+} // namespace
+
+int main(const int argc, char** argv) {
+  try {
+    Endpoint endpoint{"/tmp/1a2b.sock", 0};
+    size_t threadCount{0};
+    std::string booksDirectory{"opening_books"};
+
+    for (int i{1}; i < argc; ++i) {
+      const std::string_view option{argv[i]};
+      if (option == "--help" || option == "-h") {
+        printUsage(argv[0]);
+        return 0;
+      }
+      if (i + 1 >= argc) {
+        printUsage(argv[0]);
+        return 2;
+      }
+
+      const std::string_view value{argv[++i]};
+      if (option == "--listen") {
+        endpoint = parseEndpoint(value);
+      } else if (option == "--threads") {
+        threadCount = parseNumber<size_t>(option, value);
+      } else if (option == "--books") {
+        booksDirectory = std::string{value};
+      } else {
+        printUsage(argv[0]);
+        return 2;
+      }
+    }
+
+    // Workers inherit the mask, so only the event loop sees the signals
+    sigset_t stopSignals{};
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    const int signalFd{signalfd(-1, &stopSignals, SFD_CLOEXEC)};
+    const int wakeFd{eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)};
+    if (signalFd < 0 || wakeFd < 0) {
+      throwSystemError("signalfd/eventfd");
+    }
+    const int listenFd{listenOn(endpoint)};
+
+    const size_t workers{utils::resolveWorkerCount(threadCount)};
+    std::cerr << std::format("Serving on {} with {} worker(s)\n",
+                             formatEndpoint(endpoint), workers);
+
+    const auto start{Clock::now()};
+    Totals totals;
+    {
+      const SolverEngine engine{
+          {1, std::nullopt, OpeningBook::loadDirectory(booksDirectory)}};
+      WorkerPool pool{workers, engine, wakeFd};
+      EventLoop loop{listenFd, wakeFd, signalFd, pool};
+      totals = loop.run();
+    }
+    const double seconds{
+        std::chrono::duration<double>(Clock::now() - start).count()};
+
+    close(listenFd);
+    close(wakeFd);
+    close(signalFd);
+    if (!endpoint.path.empty()) {
+      unlink(endpoint.path.c_str());
+    }
+
+    std::cerr << std::format(
+        "Served {} connection(s), {} requests, {} guesses, {} solved games "
+        "in {:.1f} s\n",
+        totals.connections, totals.requests, totals.guesses, totals.solved,
+        seconds);
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file simulate.cpp
+ * @brief Headless batch simulation of the solver strategies
+ *
+ * Usage: 1a2b_sim [--strategy KEY|all] [--sample N] [--seed S]
+ *                 [--max-attempts N] [--threads N] [--books DIR]
+ *                 [--entropy-sample N] [--json FILE|-]
+ *
+ * Plays every valid secret (or a seeded sample) with each selected strategy
+ * and prints a text summary. With --json the report is also written as JSON;
+ * when FILE is "-" the JSON goes to stdout and the summary to stderr. With
+ * --entropy-sample, large search spaces are scored by an EntropyRace whose
+ * first sample holds N secrets, so its cost in guesses can be measured.
+ */
+
+#include "../utils/number_universe.hpp"
+#include "simulation.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Parse a non-negative integer option value
+ * @param name Option name for error messages
+ * @param text The value
+ * @return The parsed value
+ * @throws std::invalid_argument if the value is not a non-negative integer
+ */
+template <typename T>
+T parseNumber(const std::string_view name, const std::string_view text) {
+  T value{};
+  if (const auto [end, error]{
+          std::from_chars(text.data(), text.data() + text.size(), value)};
+      error != std::errc{} || end != text.data() + text.size() ||
+      std::cmp_less(value, 0)) {
+    throw std::invalid_argument(std::string{name} +
+                                " expects a non-negative integer");
+  }
+  return value;
+}
+
+void printUsage(const char* const program) {
+  std::cerr << "Usage: " << program
+            << " [--strategy KEY|all] [--sample N] [--seed S]\n"
+               "       [--max-attempts N] [--threads N] [--books DIR]\n"
+               "       [--entropy-sample N] [--json FILE|-]\n"
+               "Strategy keys: entropy, minimax, frequency, hybrid, optimal,\n"
+               "               worstcase\n";
+}
+
+} // namespace
+
+int main(const int argc, char** argv) {
+  try {
+    SimulationOptions options;
+    std::vector<HeuristicSolver::GuessStrategy> strategies;
+    std::optional<size_t> sampleSize;
+    std::optional<std::string> jsonPath;
+
+    for (int i{1}; i < argc; ++i) {
+      const std::string_view option{argv[i]};
+      if (option == "--help" || option == "-h") {
+        printUsage(argv[0]);
+        return 0;
+      }
+      if (i + 1 >= argc) {
+        printUsage(argv[0]);
+        return 2;
+      }
+
+      const std::string_view value{argv[++i]};
+      if (option == "--strategy") {
+        if (value == "all") {
+          const auto all{getAllStrategies()};
+          strategies.assign(all.begin(), all.end());
+        } else if (const auto strategy{parseStrategyKey(value)};
+                   strategy.has_value()) {
+          strategies.push_back(strategy.value());
+        } else {
+          throw std::invalid_argument("Unknown strategy: " +
+                                      std::string{value});
+        }
+      } else if (option == "--sample") {
+        sampleSize = parseNumber<size_t>(option, value);
+      } else if (option == "--seed") {
+        options.seed = parseNumber<uint64_t>(option, value);
+      } else if (option == "--max-attempts") {
+        options.maxAttempts = parseNumber<int32_t>(option, value);
+      } else if (option == "--threads") {
+        options.threadCount = parseNumber<size_t>(option, value);
+      } else if (option == "--books") {
+        options.openingBooks = OpeningBook::loadDirectory(std::string{value});
+      } else if (option == "--entropy-sample") {
+        options.entropySampling = EntropySampling{};
+        options.entropySampling->initialSample =
+            parseNumber<size_t>(option, value);
+      } else if (option == "--json") {
+        jsonPath = std::string{value};
+      } else {
+        printUsage(argv[0]);
+        return 2;
+      }
+    }
+
+    if (strategies.empty()) {
+      const auto all{getAllStrategies()};
+      strategies.assign(all.begin(), all.end());
+    }
+
+    // Every valid secret, or a reproducible sample in ascending order
+    if (sampleSize.has_value() &&
+        sampleSize.value() < utils::validNumbers.size()) {
+      if (!options.seed.has_value()) {
+        options.seed = std::random_device{}();
+      }
+      std::mt19937_64 engine{options.seed.value()};
+      std::ranges::sample(utils::validNumbers,
+                          std::back_inserter(options.secrets),
+                          static_cast<std::ptrdiff_t>(sampleSize.value()),
+                          engine);
+    } else {
+      options.secrets.assign(utils::validNumbers.begin(),
+                             utils::validNumbers.end());
+      options.seed.reset();
+    }
+
+    std::vector<StrategyReport> reports;
+    for (const auto strategy : strategies) {
+      reports.push_back(simulateStrategy(strategy, options));
+    }
+
+    const bool jsonToStdout{jsonPath.has_value() && jsonPath.value() == "-"};
+    writeText(jsonToStdout ? std::cerr : std::cout, options, reports);
+
+    if (jsonToStdout) {
+      writeJson(std::cout, options, reports);
+    } else if (jsonPath.has_value()) {
+      std::ofstream file{jsonPath.value()};
+      writeJson(file, options, reports);
+      if (!file) {
+        throw std::runtime_error("Cannot write " + jsonPath.value());
+      }
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,322 @@
+/**
+ * @file simulation.cpp
+ * @brief Implementation of headless solver games
+ */
+
+#include "simulation.hpp"
+#include "../solver/bit_sliced_universe.hpp"
+#include "../solver/feedback_table.hpp"
+#include "../solver/transposition_table.hpp"
+#include "../utils/parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <format>
+#include <iomanip>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::array allStrategies{
+    HeuristicSolver::GuessStrategy::entropyBased,
+    HeuristicSolver::GuessStrategy::miniMax,
+    HeuristicSolver::GuessStrategy::frequencyBased,
+    HeuristicSolver::GuessStrategy::hybrid,
+    HeuristicSolver::GuessStrategy::optimal,
+    HeuristicSolver::GuessStrategy::worstCase}; ///< Every strategy, in order
+
+/**
+ * @struct GameRecord
+ * @brief Outcome of one simulated game
+ */
+struct GameRecord {
+  int32_t guesses{0};         ///< Guesses made, including the final one
+  bool solved{false};         ///< Whether the secret was found in time
+  double gameMs{0.0};         ///< Wall time of the whole game
+  std::vector<double> turnMs; ///< nextGuess latency per turn
+};
+
+[[nodiscard]] double elapsedMs(const Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief Play one game against a known secret
+ * @param strategy The solver strategy
+ * @param secret The number to find
+ * @param options Attempt cap and opening books
+ * @return The game's outcome and timings
+ */
+GameRecord playGame(const HeuristicSolver::GuessStrategy strategy,
+                    const int32_t secret, const SimulationOptions& options) {
+  GameRecord record;
+  const auto gameStart{Clock::now()};
+
+  HeuristicSolver solver{strategy};
+  for (const auto& book : options.openingBooks) {
+    solver.addOpeningBook(book);
+  }
+  solver.setEntropySampling(options.entropySampling);
+
+  while (record.guesses < options.maxAttempts) {
+    const auto turnStart{Clock::now()};
+    const auto guess{solver.nextGuess()};
+    record.turnMs.push_back(elapsedMs(turnStart));
+
+    if (!guess.has_value()) {
+      break; // Solver ran out of candidates
+    }
+    ++record.guesses;
+
+    const auto [aCount, bCount]{utils::calculateAB(guess.value(), secret)};
+    if (aCount == utils::numberSize) {
+      record.solved = true;
+      break;
+    }
+    solver.updateGuess(guess.value(), aCount, bCount);
+  }
+
+  record.gameMs = elapsedMs(gameStart);
+  return record;
+}
+
+/**
+ * @brief Escape a string for a JSON string literal
+ * @param text Plain text
+ * @return Quoted JSON string
+ */
+std::string quoteJson(const std::string_view text) {
+  std::string quoted{"\""};
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+  quoted += '"';
+  return quoted;
+}
+
+} // namespace
+
+StrategyReport simulateStrategy(const HeuristicSolver::GuessStrategy strategy,
+                                const SimulationOptions& options) {
+  // Build the shared tables up front so the first games are not penalized
+  static_cast<void>(FeedbackTable::getInstance());
+  static_cast<void>(BitSlicedUniverse::getInstance());
+
+  std::vector<GameRecord> records(options.secrets.size());
+
+  const TranspositionTable& table{TranspositionTable::getInstance()};
+  const TranspositionTable::Stats tableStart{table.getStats()};
+  const std::clock_t cpuStart{std::clock()};
+  const auto wallStart{Clock::now()};
+  utils::parallelFor(
+      options.secrets.size(), utils::resolveWorkerCount(options.threadCount),
+      [&](size_t, const size_t begin, const size_t end) {
+        for (size_t i{begin}; i < end; ++i) {
+          records[i] = playGame(strategy, options.secrets[i], options);
+        }
+      });
+  const double wallMs{elapsedMs(wallStart)};
+  const std::clock_t cpuEnd{std::clock()};
+  const TranspositionTable::Stats tableEnd{table.getStats()};
+
+  StrategyReport report{};
+  report.strategy = strategy;
+  report.games = records.size();
+  report.histogram.assign(static_cast<size_t>(options.maxAttempts) + 1, 0);
+  report.wallSeconds = wallMs / 1000.0;
+  report.cpuSeconds = static_cast<double>(cpuEnd - cpuStart) /
+                      static_cast<double>(CLOCKS_PER_SEC);
+  report.transpositionHits = tableEnd.hits - tableStart.hits;
+  report.transpositionMisses = tableEnd.misses - tableStart.misses;
+
+  int64_t totalGuesses{0};
+  double totalGameMs{0.0};
+  for (const GameRecord& record : records) {
+    if (record.solved) {
+      ++report.solved;
+      totalGuesses += record.guesses;
+      report.maxGuesses = std::max(report.maxGuesses, record.guesses);
+      ++report.histogram[static_cast<size_t>(record.guesses)];
+    } else {
+      ++report.failures;
+    }
+
+    totalGameMs += record.gameMs;
+    report.maxGameMs = std::max(report.maxGameMs, record.gameMs);
+
+    if (report.turns.size() < record.turnMs.size()) {
+      report.turns.resize(record.turnMs.size());
+    }
+    for (size_t turn{0}; turn < record.turnMs.size(); ++turn) {
+      TurnStats& stats{report.turns[turn]};
+      ++stats.count;
+      stats.totalMs += record.turnMs[turn];
+      stats.maxMs = std::max(stats.maxMs, record.turnMs[turn]);
+    }
+  }
+
+  if (report.solved > 0) {
+    report.meanGuesses =
+        static_cast<double>(totalGuesses) / static_cast<double>(report.solved);
+  }
+  if (report.games > 0) {
+    report.meanGameMs = totalGameMs / static_cast<double>(report.games);
+  }
+  return report;
+}
+
+std::string_view
+getStrategyKey(const HeuristicSolver::GuessStrategy strategy) {
+  return StrategySelector::getStrategyKey(
+      HeuristicSolver::convertStrategy(strategy));
+}
+
+std::optional<HeuristicSolver::GuessStrategy>
+parseStrategyKey(const std::string_view key) {
+  const auto strategy{StrategySelector::parseStrategyKey(key)};
+  if (!strategy.has_value()) {
+    return std::nullopt;
+  }
+  return HeuristicSolver::convertStrategy(strategy.value());
+}
+
+std::span<const HeuristicSolver::GuessStrategy> getAllStrategies() {
+  return allStrategies;
+}
+
+void writeText(std::ostream& out, const SimulationOptions& options,
+               const std::span<const StrategyReport> reports) {
+  out << std::format("Secrets: {}   Max attempts: {}   Threads: {}\n",
+                     options.secrets.size(), options.maxAttempts,
+                     utils::resolveWorkerCount(options.threadCount));
+  if (options.entropySampling.has_value()) {
+    out << std::format("Entropy sampling: from {} candidates, first sample {}"
+                       "\n",
+                       options.entropySampling->minCandidates,
+                       options.entropySampling->initialSample);
+  }
+
+  for (const StrategyReport& report : reports) {
+    out << std::format("\n{}\n",
+                       HeuristicSolver::getStrategyName(report.strategy));
+    out << std::format("  Solved: {}/{}   Failures: {}\n", report.solved,
+                       report.games, report.failures);
+    out << std::format("  Guesses: mean {:.4f}   max {}\n",
+                       report.meanGuesses, report.maxGuesses);
+
+    out << "  Histogram:";
+    for (size_t guesses{1}; guesses < report.histogram.size(); ++guesses) {
+      if (report.histogram[guesses] > 0) {
+        out << std::format(" {}:{}", guesses, report.histogram[guesses]);
+      }
+    }
+    out << '\n';
+
+    out << std::format("  Time: wall {:.3f} s   cpu {:.3f} s\n",
+                       report.wallSeconds, report.cpuSeconds);
+    out << std::format("  Per game: mean {:.3f} ms   max {:.3f} ms\n",
+                       report.meanGameMs, report.maxGameMs);
+    if (const uint64_t lookups{report.transpositionHits +
+                               report.transpositionMisses};
+        lookups > 0) {
+      out << std::format("  Transpositions: {} hits   {} misses   "
+                         "hit rate {:.1f}%\n",
+                         report.transpositionHits, report.transpositionMisses,
+                         100.0 * static_cast<double>(report.transpositionHits) /
+                             static_cast<double>(lookups));
+    }
+    for (size_t turn{0}; turn < report.turns.size(); ++turn) {
+      const TurnStats& stats{report.turns[turn]};
+      out << std::format("  Turn {:>2}: {:>6} games   mean {:.3f} ms   "
+                         "max {:.3f} ms\n",
+                         turn + 1, stats.count,
+                         stats.totalMs / static_cast<double>(stats.count),
+                         stats.maxMs);
+    }
+  }
+}
+
+void writeJson(std::ostream& out, const SimulationOptions& options,
+               const std::span<const StrategyReport> reports) {
+  const auto flags{out.flags()};
+  const auto precision{out.precision()};
+  out << std::fixed << std::setprecision(6);
+
+  out << "{\n";
+  out << "  \"secrets\": " << options.secrets.size() << ",\n";
+  out << "  \"maxAttempts\": " << options.maxAttempts << ",\n";
+  out << "  \"threads\": " << utils::resolveWorkerCount(options.threadCount)
+      << ",\n";
+  out << "  \"seed\": ";
+  if (options.seed.has_value()) {
+    out << options.seed.value();
+  } else {
+    out << "null";
+  }
+  out << ",\n";
+  out << "  \"openingBooks\": " << options.openingBooks.size() << ",\n";
+  out << "  \"entropySample\": ";
+  if (options.entropySampling.has_value()) {
+    out << options.entropySampling->initialSample;
+  } else {
+    out << "null";
+  }
+  out << ",\n";
+  out << "  \"strategies\": [";
+
+  for (size_t i{0}; i < reports.size(); ++i) {
+    const StrategyReport& report{reports[i]};
+    out << (i == 0 ? "\n" : ",\n");
+    out << "    {\n";
+    out << "      \"key\": " << quoteJson(getStrategyKey(report.strategy))
+        << ",\n";
+    out << "      \"name\": "
+        << quoteJson(HeuristicSolver::getStrategyName(report.strategy))
+        << ",\n";
+    out << "      \"games\": " << report.games << ",\n";
+    out << "      \"solved\": " << report.solved << ",\n";
+    out << "      \"failures\": " << report.failures << ",\n";
+    out << "      \"meanGuesses\": " << report.meanGuesses << ",\n";
+    out << "      \"maxGuesses\": " << report.maxGuesses << ",\n";
+
+    out << "      \"histogram\": [";
+    for (size_t guesses{1}; guesses < report.histogram.size(); ++guesses) {
+      out << (guesses == 1 ? "" : ", ") << report.histogram[guesses];
+    }
+    out << "],\n";
+
+    out << "      \"wallSeconds\": " << report.wallSeconds << ",\n";
+    out << "      \"cpuSeconds\": " << report.cpuSeconds << ",\n";
+    out << "      \"meanGameMs\": " << report.meanGameMs << ",\n";
+    out << "      \"maxGameMs\": " << report.maxGameMs << ",\n";
+    out << "      \"transpositionHits\": " << report.transpositionHits
+        << ",\n";
+    out << "      \"transpositionMisses\": " << report.transpositionMisses
+        << ",\n";
+
+    out << "      \"turns\": [";
+    for (size_t turn{0}; turn < report.turns.size(); ++turn) {
+      const TurnStats& stats{report.turns[turn]};
+      out << (turn == 0 ? "\n" : ",\n");
+      out << "        {\"turn\": " << turn + 1 << ", \"games\": " << stats.count
+          << ", \"meanMs\": "
+          << stats.totalMs / static_cast<double>(stats.count)
+          << ", \"maxMs\": " << stats.maxMs << "}";
+    }
+    out << (report.turns.empty() ? "]\n" : "\n      ]\n");
+    out << "    }";
+  }
+
+  out << (reports.empty() ? "]\n" : "\n  ]\n");
+  out << "}\n";
+
+  out.flags(flags);
+  out.precision(precision);
+}
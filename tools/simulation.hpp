@@ -0,0 +1,114 @@
+/**
+ * @file simulation.hpp
+ * @brief Headless solver games against many secrets
+ */
+
+#pragma once
+
+#include "../solver/heuristic_solver.hpp"
+#include "../solver/opening_book.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct SimulationOptions
+ * @brief What to simulate and how
+ */
+struct SimulationOptions {
+  std::vector<int32_t> secrets;   ///< Secrets to play, one game each
+  int32_t maxAttempts{10};        ///< Guesses allowed per game
+  size_t threadCount{0};          ///< Games played concurrently, 0 for all
+  std::optional<uint64_t> seed{}; ///< Sampling seed, if secrets were sampled
+  std::vector<std::shared_ptr<const OpeningBook>>
+      openingBooks; ///< Books registered with every solver
+  std::optional<EntropySampling>
+      entropySampling{}; ///< Approximate entropy settings, if enabled
+};
+
+/**
+ * @struct TurnStats
+ * @brief Latency of one turn index across all games
+ */
+struct TurnStats {
+  size_t count{0};     ///< Games that reached this turn
+  double totalMs{0.0}; ///< Summed nextGuess latency
+  double maxMs{0.0};   ///< Slowest nextGuess latency
+};
+
+/**
+ * @struct StrategyReport
+ * @brief Aggregated results of one strategy
+ */
+struct StrategyReport {
+  HeuristicSolver::GuessStrategy strategy; ///< Strategy played
+  size_t games{0};                         ///< Games played
+  size_t solved{0};                        ///< Games solved within the cap
+  size_t failures{0};                      ///< Games not solved within the cap
+  double meanGuesses{0.0};                 ///< Mean guesses of solved games
+  int32_t maxGuesses{0};                   ///< Most guesses of a solved game
+  std::vector<size_t> histogram;   ///< Solved games by guess count, from 1
+  double wallSeconds{0.0};         ///< Elapsed time for all games
+  double cpuSeconds{0.0};          ///< Process CPU time for all games
+  double meanGameMs{0.0};          ///< Mean wall time per game
+  double maxGameMs{0.0};           ///< Slowest game
+  std::vector<TurnStats> turns;    ///< Latency by turn, first turn first
+  uint64_t transpositionHits{0};   ///< Guesses found in TranspositionTable
+  uint64_t transpositionMisses{0}; ///< Guesses computed and stored there
+};
+
+/**
+ * @brief Play every secret with one strategy
+ * @param strategy The strategy to evaluate
+ * @param options Secrets, attempt cap, threads and opening books
+ * @return Aggregated report; identical inputs give identical guess statistics
+ */
+[[nodiscard]] StrategyReport
+simulateStrategy(HeuristicSolver::GuessStrategy strategy,
+                 const SimulationOptions& options);
+
+/**
+ * @brief Get the command-line key of a strategy
+ * @param strategy The strategy type
+ * @return Key such as "hybrid"
+ */
+[[nodiscard]] std::string_view
+getStrategyKey(HeuristicSolver::GuessStrategy strategy);
+
+/**
+ * @brief Parse a command-line strategy key
+ * @param key Key such as "hybrid"
+ * @return The strategy, or nullopt if the key is unknown
+ */
+[[nodiscard]] std::optional<HeuristicSolver::GuessStrategy>
+parseStrategyKey(std::string_view key);
+
+/**
+ * @brief Get every strategy in declaration order
+ * @return All strategy types
+ */
+[[nodiscard]] std::span<const HeuristicSolver::GuessStrategy>
+getAllStrategies();
+
+/**
+ * @brief Print reports as aligned text
+ * @param out Destination stream
+ * @param options The options the reports were produced with
+ * @param reports One report per strategy
+ */
+void writeText(std::ostream& out, const SimulationOptions& options,
+               std::span<const StrategyReport> reports);
+
+/**
+ * @brief Print reports as a JSON document
+ * @param out Destination stream
+ * @param options The options the reports were produced with
+ * @param reports One report per strategy
+ */
+void writeJson(std::ostream& out, const SimulationOptions& options,
+               std::span<const StrategyReport> reports);
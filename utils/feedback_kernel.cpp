@@ -0,0 +1,245 @@
+/**
+ * @file feedback_kernel.cpp
+ * @brief Scalar, AVX2 and AVX-512 implementations of the feedback kernel
+ */
+
+#include "feedback_kernel.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define FEEDBACK_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace utils {
+
+namespace {
+
+// Both SIMD kernels read exactly one byte per digit and sum four bytes per
+// lane, so other variants run the scalar kernel only
+constexpr bool simdShape{numberSize == 4 && Shape::fieldBits == 8};
+
+void computeCodesScalar(const PackedNumber guess, const uint32_t* targetDigits,
+                        const uint32_t* targetMasks, const size_t count,
+                        uint8_t* codes) {
+  for (size_t i{0}; i < count; ++i) {
+    codes[i] = static_cast<uint8_t>(Shape::feedbackCode(
+        guess.digits, guess.mask, targetDigits[i], targetMasks[i]));
+  }
+}
+
+#ifdef FEEDBACK_KERNEL_X86
+
+/**
+ * @brief Score 8 targets: zero digit bytes give A, nibble popcount gives common
+ */
+__attribute__((target("avx2"))) inline __m256i
+scoreLanesAvx2(const __m256i guessDigits, const __m256i guessMask,
+               const uint32_t* targetDigits, const uint32_t* targetMasks) {
+  const __m256i ones{_mm256_set1_epi8(1)};
+  const __m256i lowNibble{_mm256_set1_epi8(0x0F)};
+  const __m256i byteSum{_mm256_set1_epi32(0x01010101)};
+  const __m256i popLut{_mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2,
+                                        3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2,
+                                        2, 3, 2, 3, 3, 4)};
+
+  const __m256i digits{
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(targetDigits))};
+  const __m256i masks{
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(targetMasks))};
+
+  const __m256i equal{
+      _mm256_and_si256(_mm256_cmpeq_epi8(digits, guessDigits), ones)};
+  const __m256i aCount{
+      _mm256_srli_epi32(_mm256_mullo_epi32(equal, byteSum), 24)};
+
+  const __m256i shared{_mm256_and_si256(masks, guessMask)};
+  const __m256i bits{_mm256_add_epi8(
+      _mm256_shuffle_epi8(popLut, _mm256_and_si256(shared, lowNibble)),
+      _mm256_shuffle_epi8(
+          popLut, _mm256_and_si256(_mm256_srli_epi16(shared, 4), lowNibble)))};
+  const __m256i common{
+      _mm256_srli_epi32(_mm256_mullo_epi32(bits, byteSum), 24)};
+
+  return _mm256_add_epi32(_mm256_slli_epi32(aCount, 2), common);
+}
+
+__attribute__((target("avx2"))) void
+computeCodesAvx2(const PackedNumber guess, const uint32_t* targetDigits,
+                 const uint32_t* targetMasks, const size_t count,
+                 uint8_t* codes) {
+  const __m256i guessDigits{
+      _mm256_set1_epi32(static_cast<int32_t>(guess.digits))};
+  const __m256i guessMask{_mm256_set1_epi32(static_cast<int32_t>(guess.mask))};
+  const __m256i laneOrder{_mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)};
+
+  size_t i{0};
+  for (; i + 32 <= count; i += 32) {
+    const __m256i c0{scoreLanesAvx2(guessDigits, guessMask, targetDigits + i,
+                                    targetMasks + i)};
+    const __m256i c1{scoreLanesAvx2(guessDigits, guessMask,
+                                    targetDigits + i + 8, targetMasks + i + 8)};
+    const __m256i c2{scoreLanesAvx2(guessDigits, guessMask,
+                                    targetDigits + i + 16,
+                                    targetMasks + i + 16)};
+    const __m256i c3{scoreLanesAvx2(guessDigits, guessMask,
+                                    targetDigits + i + 24,
+                                    targetMasks + i + 24)};
+
+    // Narrow 32 x int32 to 32 bytes; packs interleave 128-bit halves
+    const __m256i packed{_mm256_packus_epi16(_mm256_packs_epi32(c0, c1),
+                                             _mm256_packs_epi32(c2, c3))};
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(codes + i),
+                        _mm256_permutevar8x32_epi32(packed, laneOrder));
+  }
+
+  computeCodesScalar(guess, targetDigits + i, targetMasks + i, count - i,
+                     codes + i);
+}
+
+__attribute__((target("avx512f,avx512bw"))) void
+computeCodesAvx512(const PackedNumber guess, const uint32_t* targetDigits,
+                   const uint32_t* targetMasks, const size_t count,
+                   uint8_t* codes) {
+  const __m512i guessDigits{
+      _mm512_set1_epi32(static_cast<int32_t>(guess.digits))};
+  const __m512i guessMask{_mm512_set1_epi32(static_cast<int32_t>(guess.mask))};
+  const __m512i ones{_mm512_set1_epi8(1)};
+  const __m512i lowNibble{_mm512_set1_epi8(0x0F)};
+  const __m512i byteSum{_mm512_set1_epi32(0x01010101)};
+  const __m512i popLut{_mm512_broadcast_i32x4(
+      _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4))};
+
+  size_t i{0};
+  for (; i + 16 <= count; i += 16) {
+    const __m512i digits{_mm512_loadu_si512(targetDigits + i)};
+    const __m512i masks{_mm512_loadu_si512(targetMasks + i)};
+
+    const __m512i equal{_mm512_maskz_mov_epi8(
+        _mm512_cmpeq_epi8_mask(digits, guessDigits), ones)};
+    const __m512i aCount{
+        _mm512_srli_epi32(_mm512_mullo_epi32(equal, byteSum), 24)};
+
+    const __m512i shared{_mm512_and_si512(masks, guessMask)};
+    const __m512i bits{_mm512_add_epi8(
+        _mm512_shuffle_epi8(popLut, _mm512_and_si512(shared, lowNibble)),
+        _mm512_shuffle_epi8(popLut, _mm512_and_si512(
+                                        _mm512_srli_epi16(shared, 4),
+                                        lowNibble)))};
+    const __m512i common{
+        _mm512_srli_epi32(_mm512_mullo_epi32(bits, byteSum), 24)};
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(codes + i),
+                     _mm512_cvtepi32_epi8(_mm512_add_epi32(
+                         _mm512_slli_epi32(aCount, 2), common)));
+  }
+
+  computeCodesScalar(guess, targetDigits + i, targetMasks + i, count - i,
+                     codes + i);
+}
+
+#endif
+
+/**
+ * @brief Detect the best level the running CPU supports
+ */
+SimdLevel detectSimdLevel() {
+  if constexpr (!simdShape) {
+    return SimdLevel::scalar;
+  }
+#ifdef FEEDBACK_KERNEL_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+    return SimdLevel::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::avx2;
+  }
+#endif
+  return SimdLevel::scalar;
+}
+
+std::atomic<SimdLevel>& activeLevel() {
+  static std::atomic<SimdLevel> level{supportedSimdLevel()};
+  return level;
+}
+
+} // namespace
+
+void computeFeedbackCodes(const PackedNumber guess,
+                          const std::span<const uint32_t> targetDigits,
+                          const std::span<const uint32_t> targetMasks,
+                          const std::span<uint8_t> codes) {
+  if (targetMasks.size() != targetDigits.size() ||
+      codes.size() != targetDigits.size()) {
+    throw std::invalid_argument("Feedback kernel spans must have equal sizes");
+  }
+
+  switch (activeLevel().load(std::memory_order_relaxed)) {
+#ifdef FEEDBACK_KERNEL_X86
+  case SimdLevel::avx512:
+    computeCodesAvx512(guess, targetDigits.data(), targetMasks.data(),
+                       codes.size(), codes.data());
+    return;
+  case SimdLevel::avx2:
+    computeCodesAvx2(guess, targetDigits.data(), targetMasks.data(),
+                     codes.size(), codes.data());
+    return;
+#endif
+  default:
+    computeCodesScalar(guess, targetDigits.data(), targetMasks.data(),
+                       codes.size(), codes.data());
+  }
+}
+
+void accumulateFeedbackHistogram(
+    const PackedNumber guess, const std::span<const uint32_t> targetDigits,
+    const std::span<const uint32_t> targetMasks,
+    const std::span<uint32_t, feedbackCodeCount> counts) {
+  constexpr size_t blockSize{256};
+  std::array<uint8_t, blockSize> codes{};
+
+  for (size_t begin{0}; begin < targetDigits.size(); begin += blockSize) {
+    const size_t length{std::min(blockSize, targetDigits.size() - begin)};
+    computeFeedbackCodes(guess, targetDigits.subspan(begin, length),
+                         targetMasks.subspan(begin, length),
+                         std::span{codes}.first(length));
+    for (size_t i{0}; i < length; ++i) {
+      ++counts[codes[i]];
+    }
+  }
+}
+
+SimdLevel supportedSimdLevel() {
+  static const SimdLevel level{detectSimdLevel()};
+  return level;
+}
+
+SimdLevel activeSimdLevel() {
+  return activeLevel().load(std::memory_order_relaxed);
+}
+
+SimdLevel setSimdLevel(const SimdLevel level) {
+  const SimdLevel selected{std::min(level, supportedSimdLevel())};
+  activeLevel().store(selected, std::memory_order_relaxed);
+  return selected;
+}
+
+std::string_view getSimdLevelName(const SimdLevel level) {
+  switch (level) {
+  case SimdLevel::scalar:
+    return "scalar";
+  case SimdLevel::avx2:
+    return "avx2";
+  case SimdLevel::avx512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+} // namespace utils
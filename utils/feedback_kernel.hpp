@@ -0,0 +1,89 @@
+/**
+ * @file feedback_kernel.hpp
+ * @brief Batched feedback scoring with runtime SIMD dispatch
+ */
+
+#pragma once
+
+#include "utils.hpp"
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace utils {
+
+/**
+ * @enum SimdLevel
+ * @brief Instruction set used by the batched feedback kernel
+ */
+enum class SimdLevel {
+  scalar, ///< Portable scalar loop
+  avx2,   ///< 8 targets per vector, 32 per iteration
+  avx512  ///< 16 targets per vector (AVX-512F + AVX-512BW)
+};
+
+/**
+ * @struct PackedNumber
+ * @brief A number in the layout consumed by the kernel
+ */
+struct PackedNumber {
+  uint32_t digits; ///< utils::packDigits of the number
+  uint32_t mask;   ///< utils::digitMask of the number
+};
+
+/**
+ * @brief Score one guess against a block of targets
+ * @param guess The packed guess
+ * @param targetDigits utils::packDigits of each target
+ * @param targetMasks utils::digitMask of each target
+ * @param codes Output feedback codes, one per target
+ *
+ * All spans must have the same length. Codes match utils::encodeFeedback of
+ * utils::calculateAB(guess, target).
+ */
+void computeFeedbackCodes(PackedNumber guess,
+                          std::span<const uint32_t> targetDigits,
+                          std::span<const uint32_t> targetMasks,
+                          std::span<uint8_t> codes);
+
+/**
+ * @brief Add the feedback codes of one guess against a block of targets to a
+ * histogram
+ * @param guess The packed guess
+ * @param targetDigits utils::packDigits of each target
+ * @param targetMasks utils::digitMask of each target
+ * @param counts Histogram indexed by feedback code
+ */
+void accumulateFeedbackHistogram(PackedNumber guess,
+                                 std::span<const uint32_t> targetDigits,
+                                 std::span<const uint32_t> targetMasks,
+                                 std::span<uint32_t, feedbackCodeCount> counts);
+
+/**
+ * @brief Get the best instruction set supported by the running CPU
+ * @return The highest SimdLevel this process can execute, always scalar for
+ * variants other than 4 digits
+ */
+[[nodiscard]] SimdLevel supportedSimdLevel();
+
+/**
+ * @brief Get the instruction set currently used by the kernel
+ * @return The active SimdLevel
+ */
+[[nodiscard]] SimdLevel activeSimdLevel();
+
+/**
+ * @brief Force the kernel to a specific instruction set
+ * @param level Requested level, clamped to supportedSimdLevel()
+ * @return The level actually selected
+ */
+SimdLevel setSimdLevel(SimdLevel level);
+
+/**
+ * @brief Get a printable name for an instruction set
+ * @param level The level to name
+ * @return Name such as "avx2"
+ */
+[[nodiscard]] std::string_view getSimdLevelName(SimdLevel level);
+
+} // namespace utils
@@ -0,0 +1,43 @@
+/**
+ * @file game_shape.cpp
+ * @brief Explicit instantiations of the supported game variants
+ */
+
+#include "game_shape.hpp"
+
+namespace utils {
+
+// Every variant a solver can be built for is compiled in any build, so a
+// kernel that breaks one of them fails here rather than in that variant's
+// build
+template struct GameShape<3, 10>;
+template struct GameShape<4, 10>;
+template struct GameShape<5, 10>;
+template struct GameShape<4, 16>;
+template struct GameShape<6, 10>;
+
+// These are compiled only to exercise the kernels with hexadecimal nibble
+// fields; no solver is built or timed for universes of their size
+template struct GameShape<5, 16>;
+template struct GameShape<6, 16>;
+
+static_assert(GameShape<3, 10>::validNumberCount == 648);
+static_assert(StandardShape::validNumberCount == 4536);
+static_assert(GameShape<6, 10>::validNumberCount == 136080);
+static_assert(GameShape<6, 16>::maxNumber == 0xFEDCBA);
+
+// 1234 against 1324 is 2A2B, code 2 * 5 + 2
+static_assert(StandardShape::feedbackCode(StandardShape::packDigits(1234),
+                                          StandardShape::digitMask(1234),
+                                          StandardShape::packDigits(1324),
+                                          StandardShape::digitMask(1324)) ==
+              12);
+
+// 0x1A2B3C against 0x1B2A3C is 4A2B, code 4 * 7 + 2
+static_assert(GameShape<6, 16>::feedbackCode(
+                  GameShape<6, 16>::packDigits(0x1A2B3C),
+                  GameShape<6, 16>::digitMask(0x1A2B3C),
+                  GameShape<6, 16>::packDigits(0x1B2A3C),
+                  GameShape<6, 16>::digitMask(0x1B2A3C)) == 30);
+
+} // namespace utils
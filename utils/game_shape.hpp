@@ -0,0 +1,181 @@
+/**
+ * @file game_shape.hpp
+ * @brief Compile-time description of a game variant and its digit kernels
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#ifndef GAME_DIGITS
+#define GAME_DIGITS 4 ///< Digits per number, set by the GAME_DIGITS option
+#endif
+
+#ifndef GAME_ALPHABET
+#define GAME_ALPHABET 10 ///< Digit symbols, set by the GAME_ALPHABET option
+#endif
+
+namespace utils {
+
+/**
+ * @struct GameShape
+ * @brief Digit count and alphabet of a game variant, with digit kernels
+ * specialized for them
+ * @tparam Digits Digits per number
+ * @tparam Alphabet Distinct digit symbols, which is also the radix numbers
+ * are written in
+ *
+ * A number is an integer written in base Alphabet with Digits digits, the
+ * first of them non-zero. Every per-digit kernel expands over the index pack
+ * of the positions, so each instantiation compiles to straight-line code with
+ * the radix and the field widths folded into constants.
+ *
+ * Packed numbers hold one field per position, position 0 (the most
+ * significant digit) in the lowest field. Fields are bytes for up to four
+ * digits, which the SIMD feedback kernels compare bytewise, and nibbles
+ * beyond that.
+ */
+template <int32_t Digits, int32_t Alphabet> struct GameShape {
+  static_assert(Digits >= 1 && Digits <= 8, "Packed numbers hold 8 digits");
+  static_assert(Alphabet >= 2 && Alphabet <= 16, "Digits must fit a nibble");
+  static_assert(Digits <= Alphabet, "Digits of a number must be distinct");
+
+  static constexpr int32_t digits{Digits};     ///< Digits per number
+  static constexpr int32_t alphabet{Alphabet}; ///< Digit symbols
+
+  static constexpr uint32_t fieldBits{Digits <= 4 ? 8U : 4U}; ///< Per digit
+  static constexpr uint32_t fieldMask{(1U << fieldBits) - 1U}; ///< One field
+
+  static constexpr uint32_t allDigitsMask{(1U << Alphabet) -
+                                          1U}; ///< digitMask of every digit
+
+  // Decimal variants are tagged with their digit count alone, as files were
+  // before the alphabet became configurable
+  static constexpr uint32_t variantId{
+      Alphabet == 10
+          ? static_cast<uint32_t>(Digits)
+          : static_cast<uint32_t>(Digits | Alphabet << 8)}; ///< Tag in files
+
+  /**
+   * @brief Raise the radix to a power
+   * @param exponent The power, at most Digits
+   * @return Alphabet to the power of exponent
+   */
+  [[nodiscard]] static constexpr int32_t radixPower(const int32_t exponent) {
+    int32_t result{1};
+    for (int32_t i{0}; i < exponent; ++i) {
+      result *= Alphabet;
+    }
+    return result;
+  }
+
+  static constexpr int32_t minNumber{
+      radixPower(Digits - 1)}; ///< Lower bound: 1 followed by zeros
+
+  static constexpr int32_t maxNumber{[] {
+    int32_t number{0};
+    for (int32_t i{0}; i < Digits; ++i) {
+      number = number * Alphabet + (Alphabet - 1 - i);
+    }
+    return number;
+  }()}; ///< Largest number with distinct digits
+
+  static constexpr int32_t validNumberCount{[] {
+    int32_t count{Alphabet - 1};
+    for (int32_t i{1}; i < Digits; ++i) {
+      count *= Alphabet - i;
+    }
+    return count;
+  }()}; ///< Numbers with distinct digits and a non-zero lead
+
+  /**
+   * @brief Split a number into its digits
+   * @param number The number, in [0, Alphabet^Digits)
+   * @return Digits, most significant first
+   */
+  [[nodiscard]] static constexpr std::array<int32_t, Digits>
+  getDigits(const int32_t number) {
+    return [number]<size_t... Pos>(std::index_sequence<Pos...>) {
+      return std::array<int32_t, Digits>{
+          (number / radixPower(Digits - 1 - static_cast<int32_t>(Pos)) %
+           Alphabet)...};
+    }(std::make_index_sequence<Digits>{});
+  }
+
+  /**
+   * @brief Pack the digits of a number into one field per position
+   * @param number The number, in [0, Alphabet^Digits)
+   * @return Word whose field i holds the digit at position i
+   */
+  [[nodiscard]] static constexpr uint32_t packDigits(const int32_t number) {
+    const std::array<int32_t, Digits> split{getDigits(number)};
+    return [&split]<size_t... Pos>(std::index_sequence<Pos...>) {
+      return ((static_cast<uint32_t>(split[Pos]) << (fieldBits * Pos)) | ...);
+    }(std::make_index_sequence<Digits>{});
+  }
+
+  /**
+   * @brief Build the set of digits appearing in a number
+   * @param number The number, in [0, Alphabet^Digits)
+   * @return Bitmask with bit d set when digit d appears in the number
+   */
+  [[nodiscard]] static constexpr uint32_t digitMask(const int32_t number) {
+    const std::array<int32_t, Digits> split{getDigits(number)};
+    return [&split]<size_t... Pos>(std::index_sequence<Pos...>) {
+      return ((1U << split[Pos]) | ...);
+    }(std::make_index_sequence<Digits>{});
+  }
+
+  /**
+   * @brief Read one digit of a packed number
+   * @param packed Result of packDigits
+   * @param position Digit position, 0 being the most significant
+   * @return The digit at that position
+   */
+  [[nodiscard]] static constexpr uint32_t digitAt(const uint32_t packed,
+                                                  const size_t position) {
+    return (packed >> (fieldBits * position)) & fieldMask;
+  }
+
+  /**
+   * @brief Count the positions where two packed numbers agree
+   * @param guess Packed guess
+   * @param target Packed target
+   * @return The A count
+   */
+  [[nodiscard]] static constexpr uint32_t matchCount(const uint32_t guess,
+                                                     const uint32_t target) {
+    const uint32_t diff{guess ^ target};
+    return [diff]<size_t... Pos>(std::index_sequence<Pos...>) {
+      return ((digitAt(diff, Pos) == 0 ? 1U : 0U) + ...);
+    }(std::make_index_sequence<Digits>{});
+  }
+
+  /**
+   * @brief Score a guess against a target, both with distinct digits
+   * @param guessDigits Packed guess
+   * @param guessMask digitMask of the guess
+   * @param targetDigits Packed target
+   * @param targetMask digitMask of the target
+   * @return Feedback code A * (Digits + 1) + B
+   *
+   * Digits are distinct, so B is the number of shared digits minus A.
+   */
+  [[nodiscard]] static constexpr uint32_t
+  feedbackCode(const uint32_t guessDigits, const uint32_t guessMask,
+               const uint32_t targetDigits, const uint32_t targetMask) {
+    const uint32_t aCount{matchCount(guessDigits, targetDigits)};
+    const auto common{
+        static_cast<uint32_t>(std::popcount(guessMask & targetMask))};
+    return aCount * static_cast<uint32_t>(Digits) + common;
+  }
+};
+
+using StandardShape = GameShape<4, 10>; ///< The classic 4-digit decimal game
+using Shape = GameShape<GAME_DIGITS, GAME_ALPHABET>; ///< Variant being built
+
+} // namespace utils
@@ -0,0 +1,96 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Implementation of MappedFile class
+ */
+
+#include "mapped_file.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef MAPPED_FILE_POSIX
+  const int fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open " + path.string());
+  }
+
+  struct stat status{};
+  if (::fstat(fd, &status) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Cannot stat " + path.string());
+  }
+
+  m_size = static_cast<size_t>(status.st_size);
+  if (m_size > 0) {
+    void* const address{
+        ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Cannot map " + path.string());
+    }
+    m_data = static_cast<const std::byte*>(address);
+    m_mapped = true;
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  ::close(fd);
+#else
+  std::ifstream file{path, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error("Cannot open " + path.string());
+  }
+
+  m_buffer.resize(static_cast<size_t>(std::filesystem::file_size(path)));
+  if (!file.read(reinterpret_cast<char*>(m_buffer.data()),
+                 static_cast<std::streamsize>(m_buffer.size()))) {
+    throw std::runtime_error("Cannot read " + path.string());
+  }
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+#endif
+}
+
+MappedFile::~MappedFile() { release(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)},
+      m_size{std::exchange(other.m_size, 0)},
+      m_mapped{std::exchange(other.m_mapped, false)},
+      m_buffer{std::move(other.m_buffer)} {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    release();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_mapped = std::exchange(other.m_mapped, false);
+    m_buffer = std::move(other.m_buffer);
+  }
+  return *this;
+}
+
+void MappedFile::release() noexcept {
+#ifdef MAPPED_FILE_POSIX
+  if (m_mapped) {
+    ::munmap(const_cast<std::byte*>(m_data), m_size);
+  }
+#endif
+  m_data = nullptr;
+  m_size = 0;
+  m_mapped = false;
+  m_buffer.clear();
+}
+
+} // namespace utils
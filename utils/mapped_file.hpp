@@ -0,0 +1,70 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only memory mapping of a file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file's contents
+ *
+ * On POSIX systems the file is mapped with mmap, so opening is cheap and pages
+ * are shared between processes through the page cache. Elsewhere the contents
+ * are read into memory once.
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Map a file
+   * @param path Path of the file to map
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   */
+  explicit MappedFile(const std::filesystem::path& path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Move constructor
+   * @param other The mapping to take over
+   */
+  MappedFile(MappedFile&& other) noexcept;
+
+  /**
+   * @brief Move assignment operator
+   * @param other The mapping to take over
+   * @return Reference to this mapping
+   */
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * @brief Get the file contents
+   * @return Bytes of the file, valid for the lifetime of this object
+   */
+  [[nodiscard]] std::span<const std::byte> bytes() const {
+    return {m_data, m_size};
+  }
+
+private:
+  /**
+   * @brief Release the mapping, if any
+   */
+  void release() noexcept;
+
+  const std::byte* m_data{nullptr}; ///< Start of the contents
+  size_t m_size{0};                 ///< Length of the contents
+  bool m_mapped{false};             ///< Whether m_data came from mmap
+  std::vector<std::byte> m_buffer;  ///< Contents when mmap is unavailable
+};
+
+} // namespace utils
@@ -0,0 +1,153 @@
+/**
+ * @file node_file.cpp
+ * @brief Implementation of NodeFile class
+ */
+
+#include "node_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+namespace {
+
+constexpr uint32_t byteOrderMark{0x01020304}; ///< Reads differently if swapped
+
+/**
+ * @struct Header
+ * @brief Fixed-size header at the start of a tree file
+ */
+struct Header {
+  std::array<char, 8> magic; ///< NodeFile::Format::magic of the kind
+  uint32_t version;          ///< NodeFile::Format::version of the kind
+  uint32_t byteOrder;        ///< Always byteOrderMark
+  uint32_t strategy;         ///< StrategySelector::StrategyType value
+  uint32_t variant;          ///< utils::Shape::variantId of the game
+  uint32_t depth;            ///< Most guesses along a line
+  uint32_t nodeCount;        ///< Entries in the node array
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 32);
+static_assert(std::is_trivially_copyable_v<NodeFile::Node> &&
+              sizeof(NodeFile::Node) ==
+                  sizeof(uint32_t) * (1 + feedbackBucketCount));
+
+/**
+ * @brief Check that every link of a node leads further into the array
+ * @param index Node index
+ * @param children Child indices of the node
+ * @param nodeCount Number of nodes
+ * @return true if every child is 0 or a later node
+ */
+bool linksForward(const size_t index,
+                  const std::span<const uint32_t, feedbackBucketCount> children,
+                  const size_t nodeCount) {
+  return std::ranges::all_of(children, [&](const uint32_t child) {
+    return child < nodeCount && (child == 0 || child > index);
+  });
+}
+
+} // namespace
+
+NodeFile::NodeFile(const std::filesystem::path& path, const Format& format)
+    : m_file{path} {
+  const std::span<const std::byte> bytes{m_file.bytes()};
+  const std::string kind{format.name};
+  const std::string name{path.string()};
+
+  Header header{};
+  if (bytes.size() < sizeof(header)) {
+    throw std::runtime_error(kind + " is truncated: " + name);
+  }
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  if (header.magic != format.magic) {
+    throw std::runtime_error(kind + " has an unknown signature: " + name);
+  }
+  if (header.byteOrder != byteOrderMark) {
+    throw std::runtime_error(kind + " has foreign byte order: " + name);
+  }
+  if (header.version != format.version) {
+    throw std::runtime_error(kind + " has an unsupported version: " + name);
+  }
+  if (header.variant != Shape::variantId) {
+    throw std::runtime_error(kind + " is for another variant: " + name);
+  }
+  if (header.nodeCount == 0 ||
+      bytes.size() != sizeof(header) + header.nodeCount * sizeof(Node)) {
+    throw std::runtime_error(kind + " size mismatch: " + name);
+  }
+
+  m_nodes = bytes.subspan(sizeof(header));
+  m_nodeCount = header.nodeCount;
+  m_strategy = header.strategy;
+  m_depth = header.depth;
+
+  // Reject links that would leave the node array or loop back to the root
+  for (uint32_t index{0}; index < header.nodeCount; ++index) {
+    if (!linksForward(index, readNode(index).children, m_nodeCount)) {
+      throw std::runtime_error(kind + " has invalid links: " + name);
+    }
+  }
+}
+
+NodeFile::Node NodeFile::readNode(const uint32_t index) const {
+  Node node{};
+  std::memcpy(&node, m_nodes.data() + static_cast<size_t>(index) * sizeof(Node),
+              sizeof(Node));
+  return node;
+}
+
+uint32_t NodeFile::readField(const uint32_t index, const size_t field) const {
+  uint32_t value{0};
+  std::memcpy(&value,
+              m_nodes.data() + static_cast<size_t>(index) * sizeof(Node) +
+                  field * sizeof(value),
+              sizeof(value));
+  return value;
+}
+
+void NodeFile::write(const std::filesystem::path& path, const Format& format,
+                     const uint32_t strategy,
+                     const std::span<const Node> nodes) {
+  const std::string kind{format.name};
+  if (nodes.empty()) {
+    throw std::runtime_error(kind + " must contain a root position");
+  }
+
+  // Children follow their parent, so one pass finds the level of every node
+  std::vector<uint32_t> levels(nodes.size(), 0);
+  for (size_t index{0}; index < nodes.size(); ++index) {
+    if (!linksForward(index, nodes[index].children, nodes.size())) {
+      throw std::runtime_error(kind + " nodes do not form a tree");
+    }
+    for (const uint32_t child : nodes[index].children) {
+      if (child != 0) {
+        levels[child] = levels[index] + 1;
+      }
+    }
+  }
+
+  const Header header{format.magic,
+                      format.version,
+                      byteOrderMark,
+                      strategy,
+                      Shape::variantId,
+                      std::ranges::max(levels) + 1,
+                      static_cast<uint32_t>(nodes.size())};
+
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(nodes.data()),
+             static_cast<std::streamsize>(nodes.size_bytes()));
+  if (!file) {
+    throw std::runtime_error("Cannot write " + path.string());
+  }
+}
+
+} // namespace utils
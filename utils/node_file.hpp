@@ -0,0 +1,123 @@
+/**
+ * @file node_file.hpp
+ * @brief Memory-mapped tree of guesses shared by opening books and policies
+ */
+
+#pragma once
+
+#include "mapped_file.hpp"
+#include "utils.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace utils {
+
+/**
+ * @class NodeFile
+ * @brief Validated view of a file holding a tree of guesses
+ *
+ * Each node holds the guess chosen at one position and, for every feedback
+ * bucket, the index of the node reached after that feedback (0 when there is
+ * none). Node 0 is the position with an empty history, and every child comes
+ * after its parent, so following children always ends.
+ *
+ * File layout, in host byte order:
+ * - Header: an 8-byte magic naming the kind of tree, format version,
+ *   byte-order mark, strategy, variant id of the game, most guesses along a
+ *   line and node count
+ * - Node array: guess followed by feedbackBucketCount child indices
+ *
+ * Opening books and policy trees differ only in their magic and in which
+ * positions they hold, so both are read and written here.
+ */
+class NodeFile {
+public:
+  /**
+   * @struct Node
+   * @brief One position of the tree
+   */
+  struct Node {
+    int32_t guess; ///< Guess made at this position
+    std::array<uint32_t, feedbackBucketCount>
+        children; ///< Node index per feedback bucket, 0 if absent
+  };
+
+  /**
+   * @struct Format
+   * @brief What tells one kind of tree file from another
+   */
+  struct Format {
+    std::array<char, 8> magic; ///< First bytes of every file of the kind
+    uint32_t version;          ///< Current format version of the kind
+    std::string_view name;     ///< Name of the kind in error messages
+  };
+
+  /**
+   * @brief Open and validate a tree file
+   * @param path Path of the file
+   * @param format The kind of tree expected
+   * @throws std::runtime_error if the file is missing, malformed, of another
+   * kind, or written for another format version, byte order or game variant
+   */
+  NodeFile(const std::filesystem::path& path, const Format& format);
+
+  /**
+   * @brief Get the strategy whose guesses the tree holds
+   * @return The stored StrategySelector::StrategyType value, unchecked
+   */
+  [[nodiscard]] uint32_t getStrategy() const { return m_strategy; }
+
+  /**
+   * @brief Get the most guesses along a line of the tree
+   * @return Depth of the tree
+   */
+  [[nodiscard]] uint32_t getDepth() const { return m_depth; }
+
+  /**
+   * @brief Get the number of positions in the tree
+   * @return Node count
+   */
+  [[nodiscard]] size_t getNodeCount() const { return m_nodeCount; }
+
+  /**
+   * @brief Read a node
+   * @param index Node index, below getNodeCount()
+   * @return Copy of the node
+   */
+  [[nodiscard]] Node readNode(uint32_t index) const;
+
+  /**
+   * @brief Read one 32-bit field of a node
+   * @param index Node index, below getNodeCount()
+   * @param field 0 for the guess, 1 + bucket for a child
+   * @return The raw field
+   */
+  [[nodiscard]] uint32_t readField(uint32_t index, size_t field) const;
+
+  /**
+   * @brief Write a tree file
+   * @param path Destination path
+   * @param format The kind of tree
+   * @param strategy The StrategySelector::StrategyType value of the nodes
+   * @param nodes Nodes in file order, root first
+   * @throws std::runtime_error if the nodes do not form a tree or the file
+   * cannot be written
+   *
+   * The depth stored in the header is that of the deepest node.
+   */
+  static void write(const std::filesystem::path& path, const Format& format,
+                    uint32_t strategy, std::span<const Node> nodes);
+
+private:
+  MappedFile m_file;                  ///< Mapped file contents
+  std::span<const std::byte> m_nodes; ///< Node array within m_file
+  size_t m_nodeCount{0};              ///< Number of nodes
+  uint32_t m_strategy{0};             ///< Stored strategy value
+  uint32_t m_depth{0};                ///< Most guesses along a line
+};
+
+} // namespace utils
@@ -0,0 +1,53 @@
+/**
+ * @file number_universe.cpp
+ * @brief Generation of the dense index over all valid numbers
+ */
+
+#include "number_universe.hpp"
+
+namespace utils::detail {
+
+std::vector<int32_t> generateValidNumbers() {
+  std::vector<int32_t> numbers;
+  numbers.reserve(validNumberCount);
+
+  // Numbers are built digit by digit from unused digits rather than found by
+  // testing every integer in range, and trying digits in ascending order at
+  // every position yields sorted numbers
+  const auto extend{[&numbers](const auto& self, const int32_t prefix,
+                               const uint32_t used,
+                               const int32_t length) -> void {
+    if (length == numberSize) {
+      numbers.push_back(prefix);
+      return;
+    }
+    for (int32_t digit{length == 0 ? 1 : 0}; digit < alphabetSize; ++digit) {
+      if (((used >> digit) & 1U) == 0) {
+        self(self, prefix * alphabetSize + digit, used | (1U << digit),
+             length + 1);
+      }
+    }
+  }};
+  extend(extend, 0, 0U, 0);
+  return numbers;
+}
+
+std::vector<Rank> generateRanks(const std::vector<int32_t>& numbers) {
+  std::vector<Rank> ranks(validNumberRange, noRank);
+  for (size_t index{0}; index < numbers.size(); ++index) {
+    ranks[numbers[index] - minValidNumber] = static_cast<Rank>(index);
+  }
+  return ranks;
+}
+
+std::vector<uint32_t> generatePacked(const std::vector<int32_t>& numbers,
+                                     uint32_t (*pack)(int32_t)) {
+  std::vector<uint32_t> packed;
+  packed.reserve(numbers.size());
+  for (const int32_t number : numbers) {
+    packed.push_back(pack(number));
+  }
+  return packed;
+}
+
+} // namespace utils::detail
@@ -0,0 +1,106 @@
+/**
+ * @file number_universe.hpp
+ * @brief Dense index over all valid numbers
+ */
+
+#pragma once
+
+#include "utils.hpp"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Count the valid numbers with the given number of digits
+ * @param size The number of digits
+ * @return Count of numbers with unique digits and a non-zero first digit
+ */
+[[nodiscard]] consteval int32_t countValidNumbers(const int32_t size) {
+  int32_t count{alphabetSize - 1};
+  for (int32_t i{1}; i < size; ++i) {
+    count *= alphabetSize - i;
+  }
+  return count;
+}
+
+inline constexpr int32_t validNumberCount{
+    countValidNumbers(numberSize)}; ///< Size of the dense universe
+
+/// Dense rank of a valid number, 16 bits wide unless the universe needs more
+using Rank =
+    std::conditional_t<(validNumberCount < 0xFFFF), uint16_t, uint32_t>;
+
+inline constexpr Rank noRank{
+    std::numeric_limits<Rank>::max()}; ///< Rank of invalid numbers
+
+namespace detail {
+
+/**
+ * @brief Generate all valid numbers in ascending order
+ * @return Vector mapping rank to number
+ */
+[[nodiscard]] std::vector<int32_t> generateValidNumbers();
+
+/**
+ * @brief Generate the inverse of a rank-to-number mapping
+ * @param numbers Vector mapping rank to number
+ * @return Vector mapping (number - minValidNumber) to rank, noRank when invalid
+ */
+[[nodiscard]] std::vector<Rank>
+generateRanks(const std::vector<int32_t>& numbers);
+
+/**
+ * @brief Apply a packing function to every valid number
+ * @param numbers Vector mapping rank to number
+ * @param pack Packing function such as utils::packDigits
+ * @return Vector mapping rank to packed value
+ */
+[[nodiscard]] std::vector<uint32_t>
+generatePacked(const std::vector<int32_t>& numbers, uint32_t (*pack)(int32_t));
+
+} // namespace detail
+
+// The tables are built once at startup rather than by the compiler, whose
+// constant-evaluation budget ends well short of the six-digit universe
+inline const std::vector<int32_t> validNumbers{
+    detail::generateValidNumbers()}; ///< Valid numbers in ascending order
+
+inline const std::vector<Rank> numberRanks{
+    detail::generateRanks(validNumbers)}; ///< Rank by number offset
+
+inline const std::vector<uint32_t> packedDigits{
+    detail::generatePacked(validNumbers, packDigits)}; ///< packDigits by rank
+
+inline const std::vector<uint32_t> digitMasks{
+    detail::generatePacked(validNumbers, digitMask)}; ///< digitMask by rank
+
+/**
+ * @brief Get the dense rank of a number
+ * @param number The number to look up
+ * @return Rank in [0, validNumberCount), or nullopt if the number is invalid
+ */
+[[nodiscard]] inline std::optional<size_t> rank(const int32_t number) {
+  if (number < minValidNumber || number > maxValidNumber) {
+    return std::nullopt;
+  }
+  if (const Rank index{numberRanks[number - minValidNumber]};
+      index != noRank) {
+    return static_cast<size_t>(index);
+  }
+  return std::nullopt;
+}
+
+/**
+ * @brief Get the number at a dense rank
+ * @param index Rank in [0, validNumberCount)
+ * @return The corresponding valid number
+ */
+[[nodiscard]] inline int32_t unrank(const size_t index) {
+  return validNumbers[index];
+}
+
+} // namespace utils
@@ -0,0 +1,306 @@
+/**
+ * @file parallel.hpp
+ * @brief Deterministic fork-join helpers for scoring guesses on several cores
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @struct Deadline
+ * @brief When a scan stops early: a point in time, a stop request, or both
+ */
+struct Deadline {
+  std::chrono::steady_clock::time_point time{
+      std::chrono::steady_clock::time_point::max()}; ///< Time to stop by
+  std::stop_token stop; ///< Stops the scan once requested, if it has a state
+
+  /**
+   * @brief Get a deadline that never passes
+   * @return Deadline without a time or a stop request
+   */
+  [[nodiscard]] static Deadline max() { return {}; }
+
+  /**
+   * @brief Check whether a scan should stop
+   * @return true once the time has come or a stop has been requested
+   */
+  [[nodiscard]] bool hasPassed() const {
+    return stop.stop_requested() || std::chrono::steady_clock::now() >= time;
+  }
+};
+
+/**
+ * @brief Resolve a requested worker count
+ * @param workerCount Requested number of workers, 0 for one per hardware
+ * thread
+ * @return Number of workers to use, at least 1
+ */
+[[nodiscard]] inline size_t resolveWorkerCount(const size_t workerCount) {
+  if (workerCount != 0) {
+    return workerCount;
+  }
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+/**
+ * @brief Run a function over contiguous shards of an index range
+ * @param count Size of the range [0, count)
+ * @param workerCount Number of shards; shard 0 runs on the calling thread
+ * @param fn Callable taking (worker, begin, end)
+ *
+ * Shards differ in size by at most one and are processed concurrently. The
+ * call returns once every shard has finished and rethrows the first
+ * exception raised by a shard, if any.
+ */
+template <typename Fn>
+void parallelFor(const size_t count, const size_t workerCount, Fn&& fn) {
+  const size_t workers{
+      std::clamp<size_t>(workerCount, 1, std::max<size_t>(count, 1))};
+  if (workers == 1) {
+    std::invoke(fn, size_t{0}, size_t{0}, count);
+    return;
+  }
+
+  const auto shardBegin{[count, workers](const size_t worker) {
+    return count / workers * worker + std::min(worker, count % workers);
+  }};
+
+  // An exception must not escape a thread, so each shard reports its own
+  std::vector<std::exception_ptr> errors(workers);
+  const auto runShard{[&fn, &errors, &shardBegin](const size_t worker) {
+    try {
+      std::invoke(fn, worker, shardBegin(worker), shardBegin(worker + 1));
+    } catch (...) {
+      errors[worker] = std::current_exception();
+    }
+  }};
+
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (size_t worker{1}; worker < workers; ++worker) {
+      threads.emplace_back(runShard, worker);
+    }
+    runShard(0);
+  } // jthreads join here
+
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+/**
+ * @struct ArgBest
+ * @brief Winning index and score of a parallelArgBest scan
+ * @tparam Score The score type
+ */
+template <typename Score> struct ArgBest {
+  size_t index; ///< Index of the best element
+  Score score;  ///< Score of the best element
+};
+
+/**
+ * @brief Find the best-scoring index of a range on several threads
+ * @param count Size of the range [0, count)
+ * @param workerCount Number of shards to score concurrently
+ * @param score Callable taking (worker, index) and returning
+ * std::optional<Score>; nullopt excludes the index
+ * @param better Strict ordering; better(a, b) is true when a beats b
+ * @return Best index and score, or nullopt if every index was excluded
+ *
+ * Each shard keeps its own first-strictly-better winner and shards are merged
+ * in index order with the same rule, so the result is the lowest index among
+ * equal scores and matches a serial left-to-right scan exactly.
+ */
+template <typename ScoreFn, typename Better>
+[[nodiscard]] auto parallelArgBest(const size_t count, const size_t workerCount,
+                                   ScoreFn&& score, Better&& better) {
+  using Score =
+      typename std::invoke_result_t<ScoreFn&, size_t, size_t>::value_type;
+  using Result = std::optional<ArgBest<Score>>;
+
+  const auto offer{[&better](Result& best, const size_t index,
+                             const Score& value) {
+    if (!best.has_value() || std::invoke(better, value, best->score)) {
+      best = ArgBest<Score>{index, value};
+    }
+  }};
+
+  std::vector<Result> shardBest(std::max<size_t>(workerCount, 1));
+  parallelFor(count, workerCount,
+              [&](const size_t worker, const size_t begin, const size_t end) {
+                Result& best{shardBest[worker]};
+                for (size_t index{begin}; index < end; ++index) {
+                  if (const auto value{std::invoke(score, worker, index)};
+                      value.has_value()) {
+                    offer(best, index, value.value());
+                  }
+                }
+              });
+
+  Result best;
+  for (const Result& candidate : shardBest) {
+    if (candidate.has_value()) {
+      offer(best, candidate->index, candidate->score);
+    }
+  }
+  return best;
+}
+
+/**
+ * @struct RankedScan
+ * @brief Leading keys of a parallelRankUntil scan
+ * @tparam Score The score type
+ */
+template <typename Score> struct RankedScan {
+  std::vector<ArgBest<Score>> leaders; ///< Best first; index holds the key
+  bool complete;                       ///< Whether every key was scored
+};
+
+inline constexpr size_t rankBlockSize{16}; ///< Keys scored per clock check
+
+/**
+ * @brief Score blocks of keys in priority order on several threads until a
+ * deadline
+ * @tparam Score The score type
+ * @param keys Keys to score, most promising first
+ * @param workerCount Number of threads pulling blocks from the front
+ * @param leaderCount Number of leading keys to report, at least 1
+ * @param deadline No further blocks are started once it has passed
+ * @param scoreBlock Callable taking (worker, block, scores), where block is a
+ * std::span<const Key> of at most rankBlockSize consecutive keys and scores a
+ * std::span<std::optional<Score>> of the same length, initially empty, to
+ * fill; nullopt excludes the key
+ * @param better Strict ordering; better(a, b) is true when a beats b
+ * @return The best-scoring keys, best first, and whether all were scored
+ *
+ * Workers take blocks of keys in order and check the clock between blocks,
+ * so the scan overruns the deadline by at most one block per worker. The
+ * first block is always scored, so an expired deadline still yields a leader
+ * unless every key of that block is excluded.
+ *
+ * Equal scores rank the lower key first, which makes the leaders independent
+ * of the order and the worker count: a complete scan leads with the key a
+ * parallelArgBest over ascending keys picks.
+ */
+template <typename Score, typename Key, typename ScoreFn, typename Better>
+[[nodiscard]] RankedScan<Score>
+parallelRankBlocksUntil(const std::span<const Key> keys,
+                        const size_t workerCount, const size_t leaderCount,
+                        const Deadline deadline, ScoreFn&& scoreBlock,
+                        Better&& better) {
+  using Entry = ArgBest<Score>;
+
+  const size_t keep{std::max<size_t>(leaderCount, 1)};
+  const auto precedes{[&better](const Entry& lhs, const Entry& rhs) {
+    if (std::invoke(better, lhs.score, rhs.score)) {
+      return true;
+    }
+    return !std::invoke(better, rhs.score, lhs.score) && lhs.index < rhs.index;
+  }};
+  const auto offer{[&precedes, keep](std::vector<Entry>& leaders,
+                                     const Entry& entry) {
+    if (leaders.size() == keep && !precedes(entry, leaders.back())) {
+      return;
+    }
+    leaders.insert(std::ranges::upper_bound(leaders, entry, precedes), entry);
+    if (leaders.size() > keep) {
+      leaders.pop_back();
+    }
+  }};
+
+  const size_t blockCount{(keys.size() + rankBlockSize - 1) / rankBlockSize};
+  const size_t workers{
+      std::clamp<size_t>(workerCount, 1, std::max<size_t>(blockCount, 1))};
+  std::vector<std::vector<Entry>> workerLeaders(workers);
+  std::atomic<size_t> nextBlock{0};
+  std::atomic<bool> expired{false};
+
+  parallelFor(workers, workers, [&](const size_t worker, size_t, size_t) {
+    std::vector<Entry>& leaders{workerLeaders[worker]};
+    std::array<std::optional<Score>, rankBlockSize> scores;
+    for (;;) {
+      const size_t begin{nextBlock.fetch_add(rankBlockSize)};
+      if (begin >= keys.size()) {
+        return;
+      }
+      if (begin != 0 && deadline.hasPassed()) {
+        expired = true;
+        return;
+      }
+
+      const size_t length{std::min(rankBlockSize, keys.size() - begin)};
+      scores.fill(std::nullopt);
+      std::invoke(scoreBlock, worker, keys.subspan(begin, length),
+                  std::span<std::optional<Score>>{scores.data(), length});
+      for (size_t i{0}; i < length; ++i) {
+        if (scores[i].has_value()) {
+          offer(leaders,
+                Entry{static_cast<size_t>(keys[begin + i]), scores[i].value()});
+        }
+      }
+    }
+  });
+
+  RankedScan<Score> result{{}, !expired};
+  for (const auto& leaders : workerLeaders) {
+    for (const Entry& entry : leaders) {
+      offer(result.leaders, entry);
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Score keys in priority order on several threads until a deadline
+ * @param keys Keys to score, most promising first
+ * @param workerCount Number of threads pulling keys from the front
+ * @param leaderCount Number of leading keys to report, at least 1
+ * @param deadline No further keys are started once it has passed
+ * @param score Callable taking (worker, key) and returning
+ * std::optional<Score>; nullopt excludes the key
+ * @param better Strict ordering; better(a, b) is true when a beats b
+ * @return The best-scoring keys, best first, and whether all were scored
+ *
+ * Keys are scored one at a time in the blocks of parallelRankBlocksUntil,
+ * with the same deadline and tie-breaking guarantees.
+ */
+template <typename Key, typename ScoreFn, typename Better>
+[[nodiscard]] auto parallelRankUntil(const std::span<const Key> keys,
+                                     const size_t workerCount,
+                                     const size_t leaderCount,
+                                     const Deadline deadline, ScoreFn&& score,
+                                     Better&& better) {
+  using Score = typename std::invoke_result_t<ScoreFn&, size_t,
+                                              size_t>::value_type;
+  return parallelRankBlocksUntil<Score>(
+      keys, workerCount, leaderCount, deadline,
+      [&score](const size_t worker, const std::span<const Key> block,
+               const std::span<std::optional<Score>> scores) {
+        for (size_t i{0}; i < block.size(); ++i) {
+          scores[i] = std::invoke(score, worker, static_cast<size_t>(block[i]));
+        }
+      },
+      std::forward<Better>(better));
+}
+
+} // namespace utils
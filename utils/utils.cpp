@@ -47,12 +47,7 @@ std::array<int32_t, numberSize> getDigits(int32_t number) {
     throw std::runtime_error("Cannot extract digits from negative number");
   }
 
-  std::array<int32_t, numberSize> digits{};
-  for (int32_t i = numberSize - 1; i >= 0; --i) {
-    digits.at(i) = number % 10;
-    number /= 10;
-  }
-  return digits;
+  return Shape::getDigits(number);
 }
 
 std::optional<std::array<int32_t, numberSize>>
@@ -70,7 +65,7 @@ isValidGuess(const int32_t guess) {
   }
 
   // Check for unique digits
-  std::array<bool, 10> digitSeen{};
+  std::array<bool, alphabetSize> digitSeen{};
   for (const int32_t digit : guessDigits) {
     if (digitSeen.at(digit)) {
       return std::nullopt; // Duplicate digit found
@@ -88,8 +83,8 @@ std::array<int32_t, 2> calculateAB(const int32_t guess, const int32_t target) {
   int32_t As{0};
   int32_t Bs{0};
 
-  std::array<int32_t, 10> targetCount{};
-  std::array<int32_t, 10> guessCount{};
+  std::array<int32_t, alphabetSize> targetCount{};
+  std::array<int32_t, alphabetSize> guessCount{};
 
   // Count A's (correct position) and build frequency counts for B's
   for (int32_t digitIndex{0}; digitIndex < numberSize; ++digitIndex) {
@@ -102,11 +97,62 @@ std::array<int32_t, 2> calculateAB(const int32_t guess, const int32_t target) {
   }
 
   // Count B's (correct digit, wrong position)
-  for (int32_t countIndex{0}; countIndex < 10; ++countIndex) {
+  for (int32_t countIndex{0}; countIndex < alphabetSize; ++countIndex) {
     Bs += std::min(targetCount.at(countIndex), guessCount.at(countIndex));
   }
 
   return {As, Bs};
 }
 
+std::optional<std::array<int32_t, 2>>
+parseFeedback(const std::string_view input) {
+  // Find the first 'A' and 'B' of either case without lowering a copy
+  size_t aPos{std::string_view::npos};
+  size_t bPos{std::string_view::npos};
+  for (size_t i{0}; i < input.size(); ++i) {
+    const char c{input[i]};
+    if ((c == 'a' || c == 'A') && aPos == std::string_view::npos) {
+      aPos = i;
+    } else if ((c == 'b' || c == 'B') && bPos == std::string_view::npos) {
+      bPos = i;
+    }
+  }
+  if (aPos == std::string_view::npos || bPos == std::string_view::npos ||
+      aPos >= bPos || aPos == 0) {
+    return std::nullopt;
+  }
+
+  // Each count is the single digit just before its letter
+  const auto countBefore{[input](const size_t pos) -> std::optional<int32_t> {
+    if (const char c{input[pos - 1]}; c >= '0' && c <= '9') {
+      return c - '0';
+    }
+    return std::nullopt;
+  }};
+  const auto aCount{countBefore(aPos)};
+  const auto bCount{countBefore(bPos)};
+  if (!aCount.has_value() || !bCount.has_value() ||
+      aCount.value() + bCount.value() > numberSize) {
+    return std::nullopt;
+  }
+  return std::array{aCount.value(), bCount.value()};
+}
+
+std::string_view nextToken(std::string_view& rest) {
+  const size_t begin{std::min(rest.find_first_not_of(' '), rest.size())};
+  rest.remove_prefix(begin);
+  const size_t end{std::min(rest.find(' '), rest.size())};
+  const std::string_view token{rest.substr(0, end)};
+  rest.remove_prefix(end);
+  return token;
+}
+
+std::string getVariantName() {
+  std::string name{std::to_string(numberSize)};
+  if (alphabetSize != 10) {
+    name += "x" + std::to_string(alphabetSize);
+  }
+  return name;
+}
+
 } // namespace utils
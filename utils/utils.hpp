@@ -5,9 +5,13 @@
 
 #pragma once
 
+#include "game_shape.hpp"
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <string_view>
 
 /**
  * @namespace utils
@@ -15,7 +19,8 @@
  */
 namespace utils {
 
-constexpr int32_t numberSize{4}; ///< Size of numbers in the game
+constexpr int32_t numberSize{Shape::digits};     ///< Digits per number
+constexpr int32_t alphabetSize{Shape::alphabet}; ///< Distinct digit symbols
 
 /**
  * @brief Integer power function
@@ -25,40 +30,116 @@ constexpr int32_t numberSize{4}; ///< Size of numbers in the game
  */
 constexpr int32_t intPow(int32_t base, int32_t exp);
 
+// Constants for valid number range
+inline constexpr int32_t minValidNumber{Shape::minNumber};
+inline constexpr int32_t maxValidNumber{Shape::maxNumber};
+inline constexpr int32_t validNumberRange{maxValidNumber - minValidNumber + 1};
+
+// Constants for feedback encoding
+inline constexpr int32_t feedbackRadix{numberSize + 1}; ///< Radix of A in codes
+inline constexpr int32_t feedbackCodeCount{feedbackRadix *
+                                           feedbackRadix}; ///< Code range
+
 /**
- * @brief Helper functions to generate min and max valid numbers
- * @param size The number of digits
- * @return A pair containing the minimum and maximum valid numbers
- *
- * The getMinValidNumber and getMaxValidNumber functions are derived from this
+ * @brief Encode an (A, B) feedback pair into a single byte
+ * @param aCount Number of correct digits in correct positions
+ * @param bCount Number of correct digits in wrong positions
+ * @return Feedback code A * (numberSize + 1) + B, in [0, feedbackCodeCount)
+ */
+[[nodiscard]] constexpr uint8_t encodeFeedback(const int32_t aCount,
+                                               const int32_t bCount) {
+  return static_cast<uint8_t>(aCount * feedbackRadix + bCount);
+}
+
+/**
+ * @brief Decode a feedback code back into its (A, B) pair
+ * @param code Feedback code produced by encodeFeedback
+ * @return Array containing [A_count, B_count]
+ */
+[[nodiscard]] constexpr std::array<int32_t, 2>
+decodeFeedback(const uint8_t code) {
+  return {code / feedbackRadix, code % feedbackRadix};
+}
+
+/**
+ * @brief Check whether a feedback code can occur between two valid numbers
+ * @param code Feedback code produced by encodeFeedback
+ * @return false when A + B exceeds numberSize or the code is (n-1)A1B
+ */
+[[nodiscard]] consteval bool isAchievableFeedback(const int32_t code) {
+  const int32_t aCount{code / feedbackRadix};
+  const int32_t bCount{code % feedbackRadix};
+  return aCount + bCount <= numberSize &&
+         !(aCount == numberSize - 1 && bCount == 1);
+}
+
+/**
+ * @brief Count the feedback codes that can occur in a game
+ * @return Number of achievable codes (14 for the standard game)
  */
+[[nodiscard]] consteval int32_t countFeedbackBuckets() {
+  int32_t count{0};
+  for (int32_t code{0}; code < feedbackCodeCount; ++code) {
+    count += isAchievableFeedback(code) ? 1 : 0;
+  }
+  return count;
+}
 
-[[nodiscard]] consteval std::pair<int32_t, int32_t>
-getValidNumberRange(const int32_t size) {
-  int32_t min{};
-  int32_t max{};
+inline constexpr int32_t feedbackBucketCount{
+    countFeedbackBuckets()}; ///< Number of achievable feedback codes
 
-  for (int32_t i{0}; i < size; ++i) {
-    const int32_t maxDigit{9 - i % 5};
-    max = max * 10 + maxDigit;
-    min = min * 10 + (i == 0 ? 1 : 0);
+/**
+ * @brief Map feedback codes to dense bucket indices in ascending code order
+ * @return Array of bucket index per code, -1 for unachievable codes
+ */
+[[nodiscard]] consteval std::array<int8_t, feedbackCodeCount>
+generateFeedbackBuckets() {
+  std::array<int8_t, feedbackCodeCount> buckets{};
+  int8_t next{0};
+  for (int32_t code{0}; code < feedbackCodeCount; ++code) {
+    buckets[code] = isAchievableFeedback(code) ? next++ : int8_t{-1};
   }
+  return buckets;
+}
+
+inline constexpr std::array<int8_t, feedbackCodeCount> feedbackBuckets{
+    generateFeedbackBuckets()}; ///< Bucket index per feedback code
 
-  return {min, max};
+/**
+ * @brief Pack the digits of a number into one field per position
+ * @param number The number to pack (must have numberSize digits)
+ * @return Word whose field i holds the digit at position i
+ */
+[[nodiscard]] constexpr uint32_t packDigits(const int32_t number) {
+  return Shape::packDigits(number);
 }
 
-[[nodiscard]] consteval int32_t getMinValidNumber(const int32_t size) {
-  return getValidNumberRange(size).first;
+/**
+ * @brief Read one digit of a packed number
+ * @param packed Result of packDigits
+ * @param position Digit position, 0 being the most significant
+ * @return The digit at that position
+ */
+[[nodiscard]] constexpr uint32_t packedDigitAt(const uint32_t packed,
+                                               const size_t position) {
+  return Shape::digitAt(packed, position);
 }
 
-[[nodiscard]] consteval int32_t getMaxValidNumber(const int32_t size) {
-  return getValidNumberRange(size).second;
+/**
+ * @brief Build the set of digits appearing in a number
+ * @param number The number to inspect (must have numberSize digits)
+ * @return Bitmask with bit d set when digit d appears in the number
+ */
+[[nodiscard]] constexpr uint32_t digitMask(const int32_t number) {
+  return Shape::digitMask(number);
 }
 
-// Constants for valid number range
-inline constexpr int32_t minValidNumber{getMinValidNumber(numberSize)};
-inline constexpr int32_t maxValidNumber{getMaxValidNumber(numberSize)};
-inline constexpr int32_t validNumberRange{maxValidNumber - minValidNumber + 1};
+/**
+ * @brief Get the name of the variant being built
+ * @return The digit count, followed by "x" and the alphabet size unless the
+ * alphabet is decimal (e.g. "4" or "4x16")
+ */
+[[nodiscard]] std::string getVariantName();
 
 /**
  * @brief Converts a number into an array of its digits
@@ -90,4 +171,24 @@ std::optional<std::array<int32_t, numberSize>> isValidGuess(int32_t guess);
  */
 std::array<int32_t, 2> calculateAB(int32_t guess, int32_t target);
 
+/**
+ * @brief Parse feedback text such as "2A1B" or "0a4b"
+ * @param input The text; the counts are the digits just before the first 'A'
+ * and the first 'B' of either case, which must come in that order
+ * @return Array containing [A_count, B_count], or nullopt if the text is not
+ * a possible feedback
+ *
+ * The text is scanned in place without copying, so it is cheap enough for
+ * machine-driven sessions.
+ */
+[[nodiscard]] std::optional<std::array<int32_t, 2>>
+parseFeedback(std::string_view input);
+
+/**
+ * @brief Split the next space-separated token off a protocol line
+ * @param rest Unparsed text, advanced past the token
+ * @return The token, empty if none is left
+ */
+[[nodiscard]] std::string_view nextToken(std::string_view& rest);
+
 } // namespace utils